@@ -1,16 +1,29 @@
 #include "BurstFireDimmer.h"
 
-BurstFireDimmer::BurstFireDimmer(uint8_t pin, uint8_t freq) {
+BurstFireDimmer::BurstFireDimmer(uint8_t zeroCrossPin, uint8_t pin, uint8_t freq) {
+  _zeroCrossPin = zeroCrossPin;
   _pin = pin;
   _frequency = freq;
   _power = 0;
   _halfWaveCount = 0;
   _enabled = false;
+  _firedHalfWaves = 0;
+  _totalHalfWaves = 0;
   _lastZeroCrossTime = 0;
   _filterWindow = 0.15;
   _expectedPeriod = 1000000UL / (_frequency * 2);
   _minPeriod = _expectedPeriod * (1.0 - _filterWindow);
   _maxPeriod = _expectedPeriod * (1.0 + _filterWindow);
+  _histBinWidth = _expectedPeriod / 4;
+
+  _statsResetRequest = true;  // ISR clears the counters on its first edge
+  _validEdges = 0;
+  _noiseEdges = 0;
+  _missedEdges = 0;
+  for (uint8_t i = 0; i < EDGE_HIST_BINS; i++) _edgeHistogram[i] = 0;
+  _isrTimeLast = 0;
+  _isrTimeAvgQ4 = 0;
+  _isrTimeMax = 0;
 
   // Initialize callback to nullptr
   _powerCallback = nullptr;
@@ -41,6 +54,13 @@ uint8_t BurstFireDimmer::getPower() const {
 void BurstFireDimmer::begin() {
   pinMode(_pin, OUTPUT);
   digitalWrite(_pin, LOW);
+
+  pinMode(_zeroCrossPin, INPUT);
+  attachInterruptArg(digitalPinToInterrupt(_zeroCrossPin), zeroCrossIsr, this, RISING);
+}
+
+void IRAM_ATTR BurstFireDimmer::zeroCrossIsr(void* arg) {
+  static_cast<BurstFireDimmer*>(arg)->handleZeroCross();
 }
 
 void BurstFireDimmer::setFilterParameters(float window, uint8_t expectedHz) {
@@ -49,50 +69,91 @@ void BurstFireDimmer::setFilterParameters(float window, uint8_t expectedHz) {
   _expectedPeriod = 1000000UL / (_frequency * 2);
   _minPeriod = _expectedPeriod * (1.0 - _filterWindow);
   _maxPeriod = _expectedPeriod * (1.0 + _filterWindow);
+  _histBinWidth = _expectedPeriod / 4;
+  _statsResetRequest = true;
+}
+
+void BurstFireDimmer::getStats(Stats& stats) const {
+  stats.validEdges = _validEdges;
+  stats.noiseEdges = _noiseEdges;
+  stats.missedEdges = _missedEdges;
+  for (uint8_t i = 0; i < EDGE_HIST_BINS; i++) {
+    stats.edgeHistogram[i] = _edgeHistogram[i];
+  }
+  stats.histBinWidth = _histBinWidth;
+  stats.isrTimeLast = _isrTimeLast;
+  stats.isrTimeAvg = _isrTimeAvgQ4 >> 4;
+  stats.isrTimeMax = _isrTimeMax;
+}
+
+void BurstFireDimmer::resetStats() {
+  // The ISR is the only writer, so it performs the reset on its next edge
+  _statsResetRequest = true;
 }
 
-void BurstFireDimmer::handleZeroCross() {
+void IRAM_ATTR BurstFireDimmer::handleZeroCross() {
   unsigned long currentTime = micros();
   unsigned long timeSinceLast = currentTime - _lastZeroCrossTime;
+
+  if (_statsResetRequest) {
+    _validEdges = 0;
+    _noiseEdges = 0;
+    _missedEdges = 0;
+    for (uint8_t i = 0; i < EDGE_HIST_BINS; i++) _edgeHistogram[i] = 0;
+    _isrTimeAvgQ4 = 0;
+    _isrTimeMax = 0;
+    _statsResetRequest = false;
+  }
+
+  // Interval histogram covers every edge, noise included
+  unsigned long bin = _histBinWidth ? timeSinceLast / _histBinWidth : 0;
+  if (bin >= EDGE_HIST_BINS) bin = EDGE_HIST_BINS - 1;
+  _edgeHistogram[bin]++;
   
   if (timeSinceLast > _minPeriod && timeSinceLast < _maxPeriod) {
     // Valid zero-crossing
-    if (_power == 0) {
-      digitalWrite(_pin, LOW);
-    } else if (_power == 100) {
-      digitalWrite(_pin, HIGH);
-    } else {
-      bool fire = shouldFire(_halfWaveCount);
-      digitalWrite(_pin, fire ? HIGH : LOW);
-    }
-    
-    _halfWaveCount++;
-    if (_halfWaveCount >= 100) _halfWaveCount = 0;
+    _validEdges++;
+    fireHalfWave();
     _lastZeroCrossTime = currentTime;
   }
   else if (timeSinceLast < _minPeriod) {
     // Noise - ignore
-    return;
+    _noiseEdges++;
   }
   else {
     // Missed zero - count it
-    if (_power == 0) {
-      digitalWrite(_pin, LOW);
-    } else if (_power == 100) {
-      digitalWrite(_pin, HIGH);
-    } else {
-      bool fire = shouldFire(_halfWaveCount);
-      digitalWrite(_pin, fire ? HIGH : LOW);
-    }
-    
-    _halfWaveCount++;
-    if (_halfWaveCount >= 100) _halfWaveCount = 0;
+    _missedEdges++;
+    fireHalfWave();
     _lastZeroCrossTime = currentTime;
   }
+
+  uint32_t isrTime = micros() - currentTime;
+  _isrTimeLast = isrTime;
+  _isrTimeAvgQ4 += (int32_t)((isrTime << 4) - _isrTimeAvgQ4) / 16;
+  if (isrTime > _isrTimeMax) _isrTimeMax = isrTime;
+}
+
+void IRAM_ATTR BurstFireDimmer::fireHalfWave() {
+  bool fire;
+  if (_power == 0) {
+    fire = false;
+  } else if (_power == 100) {
+    fire = true;
+  } else {
+    fire = shouldFire(_halfWaveCount);
+  }
+  digitalWrite(_pin, fire ? HIGH : LOW);
+
+  // Single writer (this ISR), 32-bit stores are atomic - no locking needed
+  if (fire) _firedHalfWaves++;
+  _totalHalfWaves++;
+
+  _halfWaveCount++;
+  if (_halfWaveCount >= 100) _halfWaveCount = 0;
 }
 
 // FIXED shouldFire method:
-bool BurstFireDimmer::shouldFire(uint16_t halfWaveIndex) {
+bool IRAM_ATTR BurstFireDimmer::shouldFire(uint16_t halfWaveIndex) {
   // Bresenham-like algorithm for perfect distribution
   static int16_t error = 0;
   
@@ -5,8 +5,9 @@
 
 class BurstFireDimmer {
   public:
-    // Constructor: pin - output pin, freq - AC frequency (50 or 60Hz)
-    BurstFireDimmer(uint8_t pin, uint8_t freq = 50);
+    // Constructor: zeroCrossPin - zero-cross detector input, pin - triac
+    // output pin, freq - AC frequency (50 or 60Hz)
+    BurstFireDimmer(uint8_t zeroCrossPin, uint8_t pin, uint8_t freq = 50);
     
     // Set power level: 0-100% (0 - off, 100 - full power)
     void setPower(uint8_t power);
@@ -14,10 +15,10 @@ class BurstFireDimmer {
     // Get current power level
     uint8_t getPower() const;
     
-    // Initialize the dimmer - call in setup()
+    // Initialize the dimmer and attach the zero-cross interrupt - call in setup()
     void begin();
     
-    // Zero-crossing interrupt handler - call this from your zero-cross ISR
+    // Zero-crossing handler, called from the interrupt attached by begin()
     void handleZeroCross();
     
     // Configure filtering parameters (optional)
@@ -26,13 +27,38 @@ class BurstFireDimmer {
     // Power change callback
     typedef void (*PowerChangeCallback)(uint8_t newPower);
     void setPowerChangeCallback(PowerChangeCallback callback);
+
+    // Half-wave counters for energy metering (written only by the ISR,
+    // free-running and wrapping - consumers work with deltas)
+    uint32_t getFiredHalfWaves() const { return _firedHalfWaves; }
+    uint32_t getTotalHalfWaves() const { return _totalHalfWaves; }
+
+    // ISR diagnostics. Every field has a single writer (the ISR) and is a
+    // 32-bit word, so the main loop reads them without disabling
+    // interrupts; fields may be one edge apart from each other.
+    static const uint8_t EDGE_HIST_BINS = 8;
+    struct Stats {
+      uint32_t validEdges;
+      uint32_t noiseEdges;      // Shorter than _minPeriod, ignored
+      uint32_t missedEdges;     // Longer than _maxPeriod, treated as a missed zero
+      uint32_t edgeHistogram[EDGE_HIST_BINS];  // Inter-edge interval, bin = period / 4
+      uint32_t histBinWidth;    // us
+      uint32_t isrTimeLast;     // us
+      uint32_t isrTimeAvg;      // us, exponential average
+      uint32_t isrTimeMax;      // us
+    };
+    void getStats(Stats& stats) const;
+    void resetStats();
     
   private:
+    uint8_t _zeroCrossPin;
     uint8_t _pin;
     uint8_t _frequency;
     volatile uint8_t _power;
     volatile uint16_t _halfWaveCount;
     volatile bool _enabled;
+    volatile uint32_t _firedHalfWaves;
+    volatile uint32_t _totalHalfWaves;
     
     // Filtering variables
     volatile unsigned long _lastZeroCrossTime;
@@ -41,11 +67,28 @@ class BurstFireDimmer {
     unsigned long _maxPeriod;
     float _filterWindow;
 
+    // ISR diagnostics (see Stats)
+    volatile uint32_t _validEdges;
+    volatile uint32_t _noiseEdges;
+    volatile uint32_t _missedEdges;
+    volatile uint32_t _edgeHistogram[EDGE_HIST_BINS];
+    volatile uint32_t _isrTimeLast;
+    volatile uint32_t _isrTimeAvgQ4;   // Q4 fixed point, avg += (t - avg) / 16
+    volatile uint32_t _isrTimeMax;
+    volatile bool _statsResetRequest;
+    unsigned long _histBinWidth;
+
     // Callback pointer  // ← FIXED: Changed "/" to "//"
     PowerChangeCallback _powerCallback;
     
+    // Interrupt trampoline, arg is the dimmer
+    static void zeroCrossIsr(void* arg);
+
     // Calculate which half-waves should be ON
     bool shouldFire(uint16_t halfWaveIndex);
+
+    // Drive the triac for the current half-wave and advance the counters
+    void fireHalfWave();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "Cbor_Stream.h"
+
+// Major types
+#define CBOR_MAJOR_UINT    0
+#define CBOR_MAJOR_NEGINT  1
+#define CBOR_MAJOR_BYTES   2
+#define CBOR_MAJOR_TEXT    3
+#define CBOR_MAJOR_ARRAY   4
+#define CBOR_MAJOR_MAP     5
+#define CBOR_MAJOR_TAG     6
+#define CBOR_MAJOR_SIMPLE  7
+
+#define CBOR_INDEFINITE    31
+#define CBOR_FALSE         0xF4
+#define CBOR_TRUE          0xF5
+#define CBOR_NULL          0xF6
+#define CBOR_HALF          0xF9
+#define CBOR_FLOAT         0xFA
+#define CBOR_DOUBLE        0xFB
+#define CBOR_BREAK         0xFF
+
+CborStreamWriter::CborStreamWriter(JsonFlushFn flush, void* ctx) {
+  _flush = flush;
+  _ctx = ctx;
+  _len = 0;
+  _ok = true;
+}
+
+void CborStreamWriter::beginMap() {
+  writeByte((CBOR_MAJOR_MAP << 5) | CBOR_INDEFINITE);
+}
+
+void CborStreamWriter::end() {
+  writeByte(CBOR_BREAK);
+}
+
+void CborStreamWriter::valueUint(uint32_t value) {
+  writeHead(CBOR_MAJOR_UINT, value);
+}
+
+void CborStreamWriter::valueInt(int32_t value) {
+  if (value >= 0) {
+    writeHead(CBOR_MAJOR_UINT, value);
+  } else {
+    writeHead(CBOR_MAJOR_NEGINT, (uint32_t)(-1 - value));
+  }
+}
+
+void CborStreamWriter::valueFloat(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint8_t out[5] = { CBOR_FLOAT, (uint8_t)(bits >> 24), (uint8_t)(bits >> 16),
+                     (uint8_t)(bits >> 8), (uint8_t)bits };
+  write(out, sizeof(out));
+}
+
+void CborStreamWriter::valueBool(bool value) {
+  writeByte(value ? CBOR_TRUE : CBOR_FALSE);
+}
+
+void CborStreamWriter::valueString(const char* value) {
+  size_t len = strlen(value);
+  writeHead(CBOR_MAJOR_TEXT, len);
+  write((const uint8_t*)value, len);
+}
+
+void CborStreamWriter::valueNull() {
+  writeByte(CBOR_NULL);
+}
+
+bool CborStreamWriter::finish() {
+  flushBuffer();
+  return _ok;
+}
+
+// Initial byte plus the shortest argument encoding
+void CborStreamWriter::writeHead(uint8_t major, uint32_t arg) {
+  uint8_t out[5];
+  size_t n;
+  if (arg < 24) {
+    out[0] = (major << 5) | arg;
+    n = 1;
+  } else if (arg <= 0xFF) {
+    out[0] = (major << 5) | 24;
+    out[1] = arg;
+    n = 2;
+  } else if (arg <= 0xFFFF) {
+    out[0] = (major << 5) | 25;
+    out[1] = arg >> 8;
+    out[2] = arg;
+    n = 3;
+  } else {
+    out[0] = (major << 5) | 26;
+    out[1] = arg >> 24;
+    out[2] = arg >> 16;
+    out[3] = arg >> 8;
+    out[4] = arg;
+    n = 5;
+  }
+  write(out, n);
+}
+
+void CborStreamWriter::write(const uint8_t* data, size_t len) {
+  while (len > 0) {
+    size_t room = sizeof(_buf) - _len;
+    size_t n = (len < room) ? len : room;
+    memcpy(_buf + _len, data, n);
+    _len += n;
+    data += n;
+    len -= n;
+    if (_len == sizeof(_buf)) {
+      flushBuffer();
+    }
+  }
+}
+
+void CborStreamWriter::writeByte(uint8_t b) {
+  _buf[_len++] = b;
+  if (_len == sizeof(_buf)) {
+    flushBuffer();
+  }
+}
+
+void CborStreamWriter::flushBuffer() {
+  if (_len == 0) return;
+  if (_ok && !_flush(_ctx, (const char*)_buf, _len)) {
+    _ok = false;
+  }
+  _len = 0;
+}
+
+CborReader::CborReader(const uint8_t* data, size_t len) {
+  _data = data;
+  _len = len;
+  _pos = 0;
+}
+
+bool CborReader::readArg(uint8_t info, uint64_t& arg) {
+  if (info < 24) {
+    arg = info;
+    return true;
+  }
+  if (info > 27) return false;
+
+  size_t bytes = 1 << (info - 24);
+  if (_len - _pos < bytes) return false;
+  arg = 0;
+  for (size_t i = 0; i < bytes; i++) {
+    arg = (arg << 8) | _data[_pos++];
+  }
+  return true;
+}
+
+bool CborReader::next(CborItem& item) {
+  if (_pos >= _len) return false;
+
+  uint8_t initial = _data[_pos++];
+  uint8_t major = initial >> 5;
+  uint8_t info = initial & 0x1F;
+  uint64_t arg = 0;
+
+  memset(&item, 0, sizeof(item));
+
+  switch (major) {
+    case CBOR_MAJOR_UINT:
+      if (!readArg(info, arg) || arg > INT64_MAX) return false;
+      item.kind = CBOR_ITEM_UINT;
+      item.integer = arg;
+      return true;
+
+    case CBOR_MAJOR_NEGINT:
+      if (!readArg(info, arg) || arg > INT64_MAX) return false;
+      item.kind = CBOR_ITEM_NEGINT;
+      item.integer = -1 - (int64_t)arg;
+      return true;
+
+    case CBOR_MAJOR_TEXT:
+      if (info == CBOR_INDEFINITE) break;   // Chunked text is not supported
+      if (!readArg(info, arg) || arg > _len - _pos) return false;
+      item.kind = CBOR_ITEM_TEXT;
+      item.text = (const char*)_data + _pos;
+      item.length = arg;
+      _pos += arg;
+      return true;
+
+    case CBOR_MAJOR_ARRAY:
+    case CBOR_MAJOR_MAP:
+      item.kind = (major == CBOR_MAJOR_MAP) ? CBOR_ITEM_MAP : CBOR_ITEM_ARRAY;
+      if (info == CBOR_INDEFINITE) {
+        item.indefinite = true;
+        return true;
+      }
+      if (!readArg(info, arg)) return false;
+      item.length = arg;
+      return true;
+
+    case CBOR_MAJOR_SIMPLE:
+      switch (initial) {
+        case CBOR_FALSE:
+        case CBOR_TRUE:
+          item.kind = CBOR_ITEM_BOOL;
+          item.boolean = (initial == CBOR_TRUE);
+          return true;
+        case CBOR_NULL:
+          item.kind = CBOR_ITEM_NULL;
+          return true;
+        case CBOR_HALF:
+          if (!readArg(25, arg)) return false;
+          item.kind = CBOR_ITEM_FLOAT;
+          item.number = halfToFloat(arg);
+          return true;
+        case CBOR_FLOAT: {
+          if (!readArg(26, arg)) return false;
+          uint32_t bits = arg;
+          float f;
+          memcpy(&f, &bits, sizeof(f));
+          item.kind = CBOR_ITEM_FLOAT;
+          item.number = f;
+          return true;
+        }
+        case CBOR_DOUBLE: {
+          if (!readArg(27, arg)) return false;
+          double d;
+          memcpy(&d, &arg, sizeof(d));
+          item.kind = CBOR_ITEM_FLOAT;
+          item.number = d;
+          return true;
+        }
+        case CBOR_BREAK:
+          item.kind = CBOR_ITEM_BREAK;
+          return true;
+      }
+      break;
+  }
+
+  // Byte strings, tags and other simple values are not part of the API;
+  // their extent is not tracked, so decoding cannot continue
+  item.kind = CBOR_ITEM_UNSUPPORTED;
+  return false;
+}
+
+bool CborReader::skip(const CborItem& item, uint8_t depth) {
+  if (item.kind != CBOR_ITEM_MAP && item.kind != CBOR_ITEM_ARRAY) return true;
+  if (depth >= CBOR_MAX_SKIP_DEPTH) return false;
+
+  // Guards against a huge declared length: each item takes at least a byte
+  uint64_t items = (item.kind == CBOR_ITEM_MAP) ? 2 * (uint64_t)item.length : item.length;
+  if (!item.indefinite && items > _len - _pos) return false;
+
+  for (uint64_t i = 0; item.indefinite || i < items; i++) {
+    CborItem inner;
+    if (!next(inner)) return false;
+    if (inner.kind == CBOR_ITEM_BREAK) {
+      // Only valid where a key (or array item) may start
+      return item.indefinite && (item.kind == CBOR_ITEM_ARRAY || i % 2 == 0);
+    }
+    if (!skip(inner, depth + 1)) return false;
+  }
+  return true;
+}
+
+// IEEE 754 half precision (RFC 8949 appendix D)
+float CborReader::halfToFloat(uint16_t half) {
+  int exponent = (half >> 10) & 0x1F;
+  int mantissa = half & 0x3FF;
+  float value;
+  if (exponent == 0) {
+    value = ldexpf(mantissa, -24);
+  } else if (exponent != 31) {
+    value = ldexpf(mantissa + 1024, exponent - 25);
+  } else {
+    value = (mantissa == 0) ? INFINITY : NAN;
+  }
+  return (half & 0x8000) ? -value : value;
+}
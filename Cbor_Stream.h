@@ -0,0 +1,92 @@
+#ifndef CBOR_STREAM_H
+#define CBOR_STREAM_H
+
+#include <Arduino.h>
+#include "Json_Stream.h"
+
+#define CBOR_STREAM_BUFFER_SIZE 256
+#define CBOR_MAX_SKIP_DEPTH     8     // Nesting skip() follows before giving up
+
+// Streaming CBOR (RFC 8949) encoder with the same fixed-buffer/flush
+// model as JsonStreamWriter. Maps are written with indefinite length so
+// nothing has to be counted up front.
+class CborStreamWriter {
+  public:
+    CborStreamWriter(JsonFlushFn flush, void* ctx);
+
+    void beginMap();     // Indefinite-length map; close with end()
+    void end();
+
+    void valueUint(uint32_t value);
+    void valueInt(int32_t value);
+    void valueFloat(float value);
+    void valueBool(bool value);
+    void valueString(const char* value);
+    void valueNull();
+
+    // Flush whatever is buffered; returns false if any flush failed
+    bool finish();
+    bool ok() const { return _ok; }
+
+  private:
+    JsonFlushFn _flush;
+    void* _ctx;
+    uint8_t _buf[CBOR_STREAM_BUFFER_SIZE];
+    size_t _len;
+    bool _ok;
+
+    void writeHead(uint8_t major, uint32_t arg);
+    void write(const uint8_t* data, size_t len);
+    void writeByte(uint8_t b);
+    void flushBuffer();
+};
+
+enum CborItemKind {
+    CBOR_ITEM_UINT,
+    CBOR_ITEM_NEGINT,
+    CBOR_ITEM_TEXT,
+    CBOR_ITEM_FLOAT,
+    CBOR_ITEM_BOOL,
+    CBOR_ITEM_NULL,
+    CBOR_ITEM_MAP,
+    CBOR_ITEM_ARRAY,
+    CBOR_ITEM_BREAK,
+    CBOR_ITEM_UNSUPPORTED   // Byte strings, tags, ...: not used by the API
+};
+
+struct CborItem {
+    CborItemKind kind;
+    int64_t integer;        // UINT / NEGINT value
+    double number;          // FLOAT value
+    bool boolean;
+    const char* text;       // TEXT: points into the input, not NUL terminated
+    size_t length;          // TEXT length, MAP pair count, ARRAY item count
+    bool indefinite;        // MAP/ARRAY with a break terminator
+};
+
+// Sequential CBOR decoder over a complete in-memory buffer. Does not
+// allocate; text items point back into the input.
+class CborReader {
+  public:
+    CborReader(const uint8_t* data, size_t len);
+
+    // Decode the next item; false on truncated or malformed input
+    bool next(CborItem& item);
+
+    // Skip the contents of a MAP/ARRAY item just returned by next() (no-op
+    // for other items); false on malformed, unsupported or too deep input
+    bool skip(const CborItem& item, uint8_t depth = 0);
+
+    bool atEnd() const { return _pos >= _len; }
+    size_t getOffset() const { return _pos; }
+
+  private:
+    const uint8_t* _data;
+    size_t _len;
+    size_t _pos;
+
+    bool readArg(uint8_t info, uint64_t& arg);
+    static float halfToFloat(uint16_t half);
+};
+
+#endif
@@ -1,8 +1,15 @@
 #include "Command_processor.h"
 #include "Param_helpers.h"
+#include "Param_codec.h"
 #include "EEPROM_Manager.h"
+#include "Energy_Meter.h"
+#include "BurstFireDimmer.h"
+#include "Temperature_Sensor.h"
 
 extern EEPROMManager eepromManager;
+extern EnergyMeter energyMeter;
+extern BurstFireDimmer dimmer;
+extern Temperature_Sensor tempSensor;
 extern void showSystemStatus();
 
 void Command_processor::handleSerialCommands() {
@@ -40,6 +47,52 @@ void Command_processor::handleSerialCommands() {
       showSystemStatus();
       return;
     }
+
+    if (input == "dimmer_stats") {
+      showDimmerStats();
+      return;
+    }
+
+    if (input == "dimmer_stats_reset") {
+      dimmer.resetStats();
+      Serial.println("Dimmer ISR statistics reset");
+      return;
+    }
+
+    if (input == "probes") {
+      tempSensor.printProbes();
+      return;
+    }
+
+    if (input == "energy_reset") {
+      energyMeter.resetBatch();
+      Serial.println("Batch energy counters reset");
+      return;
+    }
+    
+    if (input == "tx_begin") {
+      tx.clear();
+      txOpen = true;
+      Serial.println("Transaction started ('tx_commit' applies, 'tx_abort' discards)");
+      return;
+    }
+
+    if (input == "tx_commit") {
+      if (!txOpen) {
+        Serial.println("Error: No open transaction");
+        return;
+      }
+      txOpen = false;
+      commitTransaction();
+      return;
+    }
+
+    if (input == "tx_abort") {
+      tx.clear();
+      txOpen = false;
+      Serial.println("Transaction discarded");
+      return;
+    }
     
     // Universal parameter handler
     int spaceIndex = input.indexOf(' ');
@@ -48,13 +101,18 @@ void Command_processor::handleSerialCommands() {
       String valueStr = input.substring(spaceIndex + 1);
       
       // Find parameter by name with SERIAL_MENU flag
-      for (int i = 0; i < PARAM_COUNT; i++) {
-        if (paramName == system_params[i].name && 
-            (system_params[i].flags & SERIAL_MENU)) {
-          setParameter(system_params[i], valueStr);
-          eepromManager.saveConfig(); // Save after successful change
-          return;
+      int i = findParamByName(paramName.c_str());
+      if (i >= 0 && (system_params[i].flags & SERIAL_MENU)) {
+        // Outside tx_begin/tx_commit every set is a one-param transaction
+        if (!txOpen) tx.clear();
+        if (stageParameter(system_params[i], valueStr)) {
+          if (txOpen) {
+            Serial.printf("%s staged (%d in transaction)\n", system_params[i].name, tx.size());
+          } else {
+            commitTransaction();
+          }
         }
+        return;
       }
       Serial.println("Error: Parameter not found or not accessible via serial");
     } else {
@@ -63,140 +121,69 @@ void Command_processor::handleSerialCommands() {
   }
 }
 
-bool Command_processor::setParameter(ConfigParam& param, const String& value) {
-  switch (param.type) {
-    case TYPE_FLOAT: {
-      float newValue = value.toFloat();
-      if (newValue >= param.number.min_value && newValue <= param.number.max_value) {
-        param.number.value = newValue;
-        Serial.print(param.name);
-        Serial.print(" set to: ");
-        Serial.println(newValue);
-        return true;
-      }
-      break;
-    }
-    
-    case TYPE_UINT8: {
-      int newValue = value.toInt();
-      if (newValue >= param.uint8.min_value && newValue <= param.uint8.max_value) {
-        param.uint8.value = newValue;
-        Serial.print(param.name);
-        Serial.print(" set to: ");
-        Serial.println(newValue);
-        return true;
-      }
-      break;
-    }
-    
-    case TYPE_UINT16: {
-      int newValue = value.toInt();
-      if (newValue >= param.uint16.min_value && newValue <= param.uint16.max_value) {
-        param.uint16.value = newValue;
-        Serial.print(param.name);
-        Serial.print(" set to: ");
-        Serial.println(newValue);
-        return true;
-      }
-      break;
+void Command_processor::commitTransaction() {
+  ParamIndex failed = PARAM_COUNT;
+  const char* error = tx.commit(&failed);   // Saves EEPROM once if needed
+  if (error) {
+    Serial.print("Error: ");
+    if (failed < PARAM_COUNT) {
+      Serial.print(system_params[failed].name);
+      Serial.print(": ");
     }
-    
-    case TYPE_INT16: {
-        int newValue = value.toInt();
-        if (newValue >= param.int16.min_value && newValue <= param.int16.max_value) {
-            param.int16.value = newValue;
-            Serial.print(param.name);
-            Serial.print(" set to: ");
-            Serial.println(newValue);
-            return true;
-        }
-        break;
-    }
-
-    case TYPE_BOOL: {
-      if (value == "1" || value == "true" || value == "on") {
-        param.boolean.value = true;
-        Serial.print(param.name);
-        Serial.println(" set to: true");
-        return true;
-      } else if (value == "0" || value == "false" || value == "off") {
-        param.boolean.value = false;
-        Serial.print(param.name);
-        Serial.println(" set to: false");
-        return true;
-      }
-      break;
-    }
-    
-    case TYPE_STRING: {
-      if (value.length() < param.string.max_size) {
-        strncpy(param.string.value, value.c_str(), param.string.max_size - 1);
-        param.string.value[param.string.max_size - 1] = '\0';
-        Serial.print(param.name);
-        Serial.print(" set to: ");
-        Serial.println(value);
-        return true;
-      }
-      break;
+    Serial.print(error);
+    Serial.println(" - nothing changed");
+  } else {
+    for (uint8_t i = 0; i < tx.size(); i++) {
+      ParamIndex index = tx.indexAt(i);
+      Serial.print(system_params[index].name);
+      Serial.print(" set to: ");
+      Serial.println(getParamDisplayValue(index));
     }
   }
-  
-  // If we get here, validation failed
-  Serial.print("Error: ");
-  Serial.print(param.name);
-  Serial.print(" must be between ");
-  
-  switch (param.type) {
-    case TYPE_FLOAT:
-      Serial.print(param.number.min_value);
-      Serial.print(" and ");
-      Serial.println(param.number.max_value);
-      break;
-    case TYPE_UINT8:
-      Serial.print(param.uint8.min_value);
-      Serial.print(" and ");
-      Serial.println(param.uint8.max_value);
-      break;
-    case TYPE_UINT16:
-      Serial.print(param.uint16.min_value);
-      Serial.print(" and ");
-      Serial.println(param.uint16.max_value);
-      break;
-    case TYPE_INT16:
-      Serial.print(param.int16.min_value);
-      Serial.print(" and ");
-      Serial.println(param.int16.max_value);
-      break;
-    case TYPE_STRING:
-      Serial.print("string up to ");
-      Serial.print(param.string.max_size - 1);
-      Serial.println(" characters");
-      break;
-    case TYPE_BOOL:
-      Serial.println("0/1, true/false, or on/off");
-      break;
+  tx.clear();
+}
+
+bool Command_processor::stageParameter(ConfigParam& param, const String& value) {
+  const char* error = tx.stageText(paramIndexOf(param), value.c_str());
+  if (!error) return true;
+
+  if (strcmp(error, "too many parameters") == 0) {
+    Serial.println("Error: Transaction is full");
+    return false;
   }
+
+  // Show the accepted input
+  char accepted[PARAM_TEXT_SIZE];
+  codecFor(param).describe(param, accepted, sizeof(accepted));
+  Serial.printf("Error: %s (%s) must be %s\n", param.name, error, accepted);
   
   return false;
 }
 
 void Command_processor::showHelp() {
   Serial.println("Available commands:");
-  for (int i = 0; i < PARAM_COUNT; i++) {
-    if (system_params[i].flags & SERIAL_MENU) {
-      Serial.print("  ");
-      Serial.print(system_params[i].name);
-      Serial.print(" (");
-      Serial.print(typeToString(system_params[i].type));
-      Serial.print(") - ");
-      Serial.println(system_params[i].description);
-    }
+  ParamList menu = getParamList(PARAM_LIST_SERIAL);
+  for (uint8_t i = 0; i < menu.count; i++) {
+    const ConfigParam& param = system_params[menu[i]];
+    Serial.print("  ");
+    Serial.print(param.name);
+    Serial.print(" (");
+    Serial.print(typeToString(param.type));
+    Serial.print(") - ");
+    Serial.println(param.description);
   }
   Serial.println("  help - Show this help");
   Serial.println("  show - Show all parameters");
   Serial.println("  save - Save configuration to EEPROM");
   Serial.println("  load_defaults - Reset configuration to defaults");
   Serial.println("  status - Show system status");
+  Serial.println("  energy_reset - Start a new batch (reset batch energy)");
+  Serial.println("  probes - Show temperature probes and their roles");
+  Serial.println("  dimmer_stats - Show zero-cross ISR diagnostics");
+  Serial.println("  dimmer_stats_reset - Reset zero-cross ISR diagnostics");
+  Serial.println("  tx_begin - Stage the following parameter sets");
+  Serial.println("  tx_commit - Validate and apply staged sets together");
+  Serial.println("  tx_abort - Discard staged sets");
 }
 
 void Command_processor::showAllParameters() {
@@ -207,35 +194,41 @@ void Command_processor::showAllParameters() {
     Serial.print(p.name);
     Serial.print(" = ");
     
-    if (p.flags & SECURED_VALUE) {
-      Serial.print("******");
-    } else {
-      switch (p.type) {
-        case TYPE_FLOAT:
-          Serial.print(p.number.value);
-          break;
-        case TYPE_UINT8:
-          Serial.print(p.uint8.value);
-          break;
-        case TYPE_UINT16:
-          Serial.print(p.uint16.value);
-          break;
-        case TYPE_INT16:
-          Serial.print(p.int16.value);
-          break;
-        case TYPE_BOOL:
-          Serial.print(p.boolean.value ? "true" : "false");
-          break;
-        case TYPE_STRING:
-          Serial.print("\"");
-          Serial.print(p.string.value);
-          Serial.print("\"");
-          break;
-      }
-    }
+    char text[PARAM_TEXT_SIZE];
+    formatParam(static_cast<ParamIndex>(i), PARAM_FORMAT_RAW, text, sizeof(text));
+    bool quoted = (p.type == TYPE_STRING) && !(p.flags & SECURED_VALUE);
+    if (quoted) Serial.print("\"");
+    Serial.print(text);
+    if (quoted) Serial.print("\"");
     
     Serial.print(" (");
     Serial.print(p.description);
     Serial.println(")");
   }
+}
+
+void Command_processor::showDimmerStats() {
+  BurstFireDimmer::Stats stats;
+  dimmer.getStats(stats);
+
+  Serial.println("=== Dimmer ISR Statistics ===");
+  Serial.printf("Edges: %lu valid, %lu noise, %lu missed\n",
+                (unsigned long)stats.validEdges,
+                (unsigned long)stats.noiseEdges,
+                (unsigned long)stats.missedEdges);
+  Serial.printf("ISR time: %lu us last, %lu us avg, %lu us max\n",
+                (unsigned long)stats.isrTimeLast,
+                (unsigned long)stats.isrTimeAvg,
+                (unsigned long)stats.isrTimeMax);
+  Serial.println("Edge interval histogram:");
+  for (uint8_t i = 0; i < BurstFireDimmer::EDGE_HIST_BINS; i++) {
+    unsigned long from = i * stats.histBinWidth;
+    if (i == BurstFireDimmer::EDGE_HIST_BINS - 1) {
+      Serial.printf("  >= %5lu us: %lu\n", from, (unsigned long)stats.edgeHistogram[i]);
+    } else {
+      Serial.printf("  %5lu-%5lu us: %lu\n", from, from + stats.histBinWidth,
+                    (unsigned long)stats.edgeHistogram[i]);
+    }
+  }
+  Serial.println("=============================");
 }
\ No newline at end of file
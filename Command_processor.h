@@ -3,15 +3,22 @@
 
 #include <Arduino.h>
 #include "Param_types.h"
+#include "Param_transaction.h"
 
 class Command_processor {
 public:
     void handleSerialCommands();
     void showHelp();
     void showAllParameters();
+    void showDimmerStats();
     
 private:
-    bool setParameter(ConfigParam& param, const String& value);
+    // Serial sets go through a transaction; tx_begin keeps it open
+    ParamTransaction tx;
+    bool txOpen = false;
+
+    bool stageParameter(ConfigParam& param, const String& value);
+    void commitTransaction();
 };
 
 #endif
\ No newline at end of file
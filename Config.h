@@ -17,15 +17,22 @@
 #define DISPLAY_SDA_PIN    8
 #define DISPLAY_SCL_PIN    9
 
+#define DISPLAY_FLUSH_PRIORITY   1     // FreeRTOS priority of the OLED flush task (low)
+#define DISPLAY_FLUSH_STACK_SIZE 2048
+
 // System Configuration
 // ====================
-#define CONFIG_VERSION 1
+#define CONFIG_VERSION 1           // EEPROM record schema; bump when a param index changes meaning
 #define FIRMWARE_VERSION "1.0.0"
 #define SERIAL_BAUD_RATE 115200
 #define ARDUINO_USB_CDC_ON_BOOT 1
 
 #define WIFI_TIMEOUT 30000  // 30 seconds timeout
 
+#define PARAM_BUS_QUEUE_SIZE      32  // Pending change events; overflow falls back to a rescan
+#define PARAM_BUS_MAX_SUBSCRIBERS 8
+#define PARAM_STRING_ARENA_SIZE   384 // Sum of the string params' max_size (320 today)
+
 // HTTPS API Configuration
 // ======================
 #define HTTPS_PORT           443  // Standard HTTPS port
@@ -35,11 +42,19 @@
 #define HTTP_MAX_CLIENTS 2      // Reduce from default 4
 #define HTTP_REQUEST_SIZE 1024  // Reduce from 2048
 #define HTTP_RESPONSE_SIZE 2048 // Reduce from 4096
+#define API_MAX_BODY_SIZE  8192 // Largest accepted /api/set body (streamed)
+#define API_MAX_QUERY_SIZE 256  // ?fields= list for GET /api/config
+#define API_MAX_CBOR_BODY_SIZE 1024 // CBOR /api/set body, decoded from one stack buffer
+#define SSE_MAX_SUBSCRIBERS (HTTP_MAX_CLIENTS - 1) // Always leave a socket for API calls
+#define REQUEST_ARENA_SIZE 4096 // Per-request cJSON arena; larger falls back to heap
 
 // SSL Certificate Configuration
 // =============================
 #define SSL_CERT_EXPIRY      365   // Certificate validity in days
 #define SSL_KEY_SIZE         2048  // RSA key size (2048 or 4096)
+#define SSL_USE_ECDSA_CERT   0     // 1 = serve server_cert_ecdsa/server_key_ecdsa (P-256) from cert.h
+#define SSL_SESSION_TICKETS  1     // Resume TLS sessions (ignored unless the core has CONFIG_ESP_TLS_SERVER_SESSION_TICKETS)
+#define HTTP_KEEP_ALIVE_IDLE 30    // TCP keep-alive (dead peer) probe after idle seconds
 
 // API Security Configuration
 // ==========================
@@ -76,5 +91,6 @@
 #define PID_COMPUTE_INTERVAL 1000
 
 #define TEMP_SENSOR_PRECISION 12
+#define TEMP_MAX_BUS_DEVICES  8    // OneWire devices scanned for probe roles
 
 #endif
\ No newline at end of file
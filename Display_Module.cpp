@@ -1,10 +1,12 @@
 #include "Display_Module.h"
 #include "Param_helpers.h"
+#include "Param_codec.h"
+#include "Param_bus.h"
+#include "Time_Service.h"
 #include "Icons.h"
 #include <WiFi.h>
 
 extern ConfigParam system_params[PARAM_COUNT];
-extern String getTimeHHMM();
 DisplayModule displayModule;
 
 DisplayModule::DisplayModule() : display(0x3C, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN) {}
@@ -13,10 +15,37 @@ bool DisplayModule::begin() {
     display.init();
     display.setFont(ArialMT_Plain_10);
     display.flipScreenVertically();
+    display.beginAsync(DISPLAY_FLUSH_PRIORITY, DISPLAY_FLUSH_STACK_SIZE);
+    paramBus.subscribeFlags(DISPLAY_ACCESS, onParamChanged, this);
     return true;
 }
 
+void DisplayModule::onParamChanged(ParamIndex index, uint32_t generation, void* ctx) {
+    static_cast<DisplayModule*>(ctx)->markDirty();
+}
+
+// Redraw only when something shown changed (a DISPLAY_ACCESS parameter,
+// the mode, the selection or a status-bar field), at most display_max_fps
+// times per second. Rendering happens here; the driver's task sends the
+// changed page spans in the background, so loop() never waits on I2C.
 void DisplayModule::update() {
+    unsigned long now = millis();
+    if (now - i2cWindowStart >= 1000) {
+        i2cBytesPerSecond = display.takeBytesSent() * 1000.0f / (now - i2cWindowStart);
+        i2cWindowStart = now;
+    }
+    
+    uint8_t maxFps = getParamUint8(PARAM_DISPLAY_MAX_FPS);
+    if (now - lastFrame < 1000UL / (maxFps ? maxFps : 1)) return;   // Changes stay pending
+    lastFrame = now;
+    
+    if (readStatusBar()) dirty = true;
+    if (readSelectedComputed()) dirty = true;
+    if (!dirty) return;
+    if (display.isFlushing()) return;   // Previous frame still on the bus; retry next slot
+    dirty = false;
+    
+    uint32_t renderStart = micros();
     display.clear();
     
     switch (currentMode) {
@@ -31,7 +60,9 @@ void DisplayModule::update() {
             break;
     }
     
-    display.display();
+    renderUs = micros() - renderStart;
+    
+    display.submit();
 }
 
 void DisplayModule::drawMainScreen() {
@@ -105,64 +136,81 @@ void DisplayModule::drawParamEdit() {
 }
 
 String DisplayModule::getParamValueString(int paramIndex) {
-    // Использовать ParamIndex и хелперы
-    ParamIndex index = static_cast<ParamIndex>(paramIndex);
-    
-    switch (system_params[paramIndex].type) {
-        case TYPE_FLOAT:
-            return String(getParamFloat(index), 1);
-        case TYPE_UINT8:
-            return String(getParamUint8(index));
-        case TYPE_UINT16:
-            return String(getParamUint16(index));
-        case TYPE_INT16:
-            return String(getParamInt16(index));
-        case TYPE_BOOL:
-            return getParamBool(index) ? "ON" : "OFF";
-        case TYPE_STRING:
-            return String(getParamString(index));
-        default:
-            return "?";
-    }
+    // Display form from the type codec (decimals follow the step, ON/OFF)
+    char text[PARAM_TEXT_SIZE];
+    formatParam(static_cast<ParamIndex>(paramIndex), PARAM_FORMAT_DISPLAY, text, sizeof(text));
+    return String(text);
 }
 
-void DisplayModule::drawStatusBar() {
-    display.setFont(ArialMT_Plain_10);
-    display.setTextAlignment(TEXT_ALIGN_LEFT);
-    
-    bool wifiConnected = WiFi.status() == WL_CONNECTED;
-    static bool wifiBlinkState = false;
-    static unsigned long wifiBlinkTimer = 0;
+// Sample the status-bar fields; true if any differs from the last frame
+bool DisplayModule::readStatusBar() {
+    StatusBar next = {};
+    next.wifiConnected = WiFi.status() == WL_CONNECTED;
     
-    if (!wifiConnected) {
+    if (!next.wifiConnected) {
         if (millis() - wifiBlinkTimer > 500) {
             wifiBlinkState = !wifiBlinkState;
             wifiBlinkTimer = millis();
         }
-        if (wifiBlinkState) {
-            display.drawXbm(0, 0, 10, 10, wifi_icon_10x10);
-        }
+        next.wifiIconShown = wifiBlinkState;
     } else {
+        next.wifiIconShown = true;
+        next.rssi = WiFi.RSSI();
+    }
+    
+    formatParam(PARAM_UPTIME, PARAM_FORMAT_DISPLAY, next.uptime, sizeof(next.uptime));
+    strncpy(next.clock, timeService.getHHMM(), sizeof(next.clock) - 1);
+    
+    if (memcmp(&next, &status, sizeof(status)) == 0) return false;
+    status = next;
+    return true;
+}
+
+// COMPUTED params never reach the bus, so a selected one is sampled each
+// frame slot like the status bar; true if its shown value changed
+bool DisplayModule::readSelectedComputed() {
+    if (currentMode == MAIN_SCREEN || selectedParamIndex < 0 || selectedParamIndex >= PARAM_COUNT ||
+        !(system_params[selectedParamIndex].flags & COMPUTED)) {
+        selectedComputed[0] = '\0';
+        return false;
+    }
+    
+    char next[PARAM_TEXT_SIZE];
+    formatParam(static_cast<ParamIndex>(selectedParamIndex), PARAM_FORMAT_DISPLAY, next, sizeof(next));
+    if (strcmp(next, selectedComputed) == 0) return false;
+    strcpy(selectedComputed, next);
+    return true;
+}
+
+void DisplayModule::drawStatusBar() {
+    display.setFont(ArialMT_Plain_10);
+    display.setTextAlignment(TEXT_ALIGN_LEFT);
+    
+    if (status.wifiIconShown) {
         display.drawXbm(0, 0, 10, 10, wifi_icon_10x10);
-        display.drawString(12, 0, String(WiFi.RSSI()));
+    }
+    if (status.wifiConnected) {
+        display.drawString(12, 0, String(status.rssi));
     }
     
     String modeStr = "M";
     display.drawString(28, 0, modeStr);
 
-    display.drawString(38, 0, getParamString(PARAM_UPTIME));
+    display.drawString(38, 0, status.uptime);
     
-    display.drawString(100, 0, getTimeHHMM());
+    display.drawString(100, 0, status.clock);
 }
 
 void DisplayModule::setMode(DisplayMode newMode) {
     currentMode = newMode;
     lastActivity = millis();
+    dirty = true;
 }
 
 void DisplayModule::setSelectedParam(int paramIndex) {
     if (paramIndex >= 0 && paramIndex < PARAM_COUNT) {
         selectedParamIndex = paramIndex;
         lastActivity = millis();
+        dirty = true;
     }
 }
\ No newline at end of file
@@ -2,9 +2,10 @@
 #define DISPLAY_MODULE_H
 
 
-#include <SH1106Wire.h>
+#include "SH1106_Dirty.h"
 #include "Config.h"
 #include "Param_types.h"
+#include "Param_codec.h"
 
 
 enum DisplayMode {
@@ -21,13 +22,41 @@ class DisplayModule {
     void setMode(DisplayMode newMode);
     void setSelectedParam(int paramIndex);
     void setEditValue(float newValue);
+    void markDirty() { dirty = true; }
+    float getI2cBytesPerSecond() const { return i2cBytesPerSecond; }
+    uint32_t getRenderUs() const { return renderUs; }
+    uint32_t getFlushUs() const { return display.getLastFlushUs(); }
     
   private:
+    // What the status bar shows; a difference from the last frame
+    // triggers a redraw
+    struct StatusBar {
+        bool wifiConnected;
+        bool wifiIconShown;         // Blinks while disconnected
+        int8_t rssi;
+        char uptime[16];
+        char clock[6];
+    };
+    
     // Display pins from Config.h
-    SH1106Wire display;
+    SH1106DirtyWire display;
     DisplayMode currentMode = MAIN_SCREEN;
     int selectedParamIndex = 0;
     unsigned long lastActivity = 0;
+    bool dirty = true;              // Something shown changed since the last frame
+    unsigned long lastFrame = 0;    // Last frame slot (display_max_fps)
+    StatusBar status = {};
+    char selectedComputed[PARAM_TEXT_SIZE] = "";   // Last shown value of a COMPUTED selection
+    bool wifiBlinkState = false;
+    unsigned long wifiBlinkTimer = 0;
+    unsigned long i2cWindowStart = 0;
+    float i2cBytesPerSecond = 0;
+    uint32_t renderUs = 0;
+    
+    bool readStatusBar();
+    bool readSelectedComputed();
+    
+    static void onParamChanged(ParamIndex index, uint32_t generation, void* ctx);
     
     void drawMainScreen();
     void drawParamScroll();
@@ -1,18 +1,128 @@
 #include "EEPROM_Manager.h"
 #include "Param_helpers.h"
+#include "Param_codec.h"
+#include "Config.h"
 #include <EEPROM.h>
 
 #define EEPROM_SIZE 4096
-#define CONFIG_MAGIC 0xFEED1234
+#define CONFIG_MAGIC 0xFEED1235
 
 extern EEPROMManager eepromManager;
 
+// Header followed by `length` bytes of records:
+//   [index u16 LE][len u8][payload, codec serialize form]
+// Records for indices this build does not know (or no longer saves) are
+// skipped on load, so adding or retiring parameters keeps the rest.
 struct EEPROMHeader {
     uint32_t magic;
     uint32_t version;
-    uint32_t checksum;
+    uint32_t checksum;   // FNV-1a over the record area
+    uint16_t length;
+    uint16_t count;
 };
 
+#define RECORD_HEADER_SIZE 3
+#define RECORD_MAX_PAYLOAD 255
+
+static uint32_t fnv1a(uint32_t hash, uint8_t byte) {
+    return (hash ^ byte) * 16777619UL;
+}
+
+#define FNV1A_SEED 2166136261UL
+
+// The 0xFEED1234 layout this format replaced: magic, version (the
+// "version" param) and an additive checksum, then a raw ConfigParam per
+// saved param in the enum order of that build. It is read once and
+// rewritten as records, so an upgrade keeps WiFi, token and setpoints.
+#define LEGACY_CONFIG_MAGIC  0xFEED1234
+#define LEGACY_HEADER_SIZE   12    // magic, version, checksum
+#define LEGACY_RECORD_SIZE   88    // sizeof(ConfigParam) of that build
+#define LEGACY_TYPE_OFFSET   8     // ParamType type
+#define LEGACY_VALUE_OFFSET  16    // First member of the value union
+#define LEGACY_STRING_SIZE   64
+
+struct LegacyParam {
+    uint8_t index;        // Position in the old enum, part of the checksum
+    ParamIndex param;
+};
+
+// Params the old layout saved (NO_FLASH_SAVE excluded), in stored order
+static const LegacyParam legacyParams[] = {
+    {  0, PARAM_VERSION },
+    {  2, PARAM_POWER_LEVEL },
+    {  3, PARAM_TEMP_SETPOINT },
+    {  4, PARAM_TEMP_SETPOINT_MIN },
+    {  5, PARAM_TEMP_SETPOINT_MAX },
+    {  6, PARAM_TEMP_HYSTERESIS },
+    {  8, PARAM_TEMP_CALIBRATION },
+    {  9, PARAM_TEMP_SENSOR_TYPE },
+    { 10, PARAM_UPDATE_INTERVAL },
+    { 12, PARAM_PID_KP },
+    { 13, PARAM_PID_KI },
+    { 14, PARAM_PID_KD },
+    { 15, PARAM_PID_SAMPLE_TIME },
+    { 16, PARAM_PID_MAX_POWER },
+    { 17, PARAM_PID_MIN_POWER },
+    { 18, PARAM_PID_MAX_TEMP_DIFF },
+    { 19, PARAM_PID_MIN_TEMP_DIFF },
+    { 20, PARAM_PID_SWITCHING_DELTA },
+    { 22, PARAM_OPERATING_MODE },
+    { 23, PARAM_WIFI_SSID },
+    { 24, PARAM_WIFI_PASSWORD },
+    { 25, PARAM_MQTT_SERVER },
+    { 26, PARAM_MQTT_PORT },
+    { 27, PARAM_API_TOKEN },
+    { 28, PARAM_HTTPS_ENABLED },
+    { 29, PARAM_HTTPS_PORT },
+    { 30, PARAM_NTP_SERVER },
+    { 31, PARAM_NTP_GMT_OFFSET },
+    { 32, PARAM_NTP_DAYLIGHT_OFFSET },
+};
+
+#define LEGACY_PARAM_COUNT (sizeof(legacyParams) / sizeof(legacyParams[0]))
+
+// Read the value of one legacy record; false if its stored type is not
+// the type the param has today
+static bool readLegacyValue(int addr, ParamType type, ParamValue& value) {
+    uint32_t storedType;
+    EEPROM.get(addr + LEGACY_TYPE_OFFSET, storedType);
+    if (storedType != (uint32_t)type) return false;
+
+    int valueAddr = addr + LEGACY_VALUE_OFFSET;
+    switch (type) {
+        case TYPE_FLOAT:  EEPROM.get(valueAddr, value.number); break;
+        case TYPE_UINT8:  value.uint8 = EEPROM.read(valueAddr); break;
+        case TYPE_UINT16: EEPROM.get(valueAddr, value.uint16); break;
+        case TYPE_INT16:  EEPROM.get(valueAddr, value.int16); break;
+        case TYPE_BOOL:   value.boolean = EEPROM.read(valueAddr) != 0; break;
+        case TYPE_STRING:
+            for (int j = 0; j < LEGACY_STRING_SIZE; j++) {
+                value.string[j] = EEPROM.read(valueAddr + j);
+            }
+            value.string[LEGACY_STRING_SIZE - 1] = '\0';
+            break;
+    }
+    return true;
+}
+
+// The old checksum term of one value, computed as the old firmware did
+static uint32_t legacyChecksum(ParamType type, const ParamValue& value) {
+    uint32_t sum = 0;
+    switch (type) {
+        case TYPE_FLOAT:  sum = (uint32_t)(value.number * 1000); break;
+        case TYPE_UINT8:  sum = value.uint8; break;
+        case TYPE_UINT16: sum = value.uint16; break;
+        case TYPE_INT16:  sum = value.int16; break;
+        case TYPE_BOOL:   sum = value.boolean ? 1 : 0; break;
+        case TYPE_STRING:
+            for (int j = 0; j < 8 && value.string[j] != '\0'; j++) {
+                sum += value.string[j];
+            }
+            break;
+    }
+    return sum;
+}
+
 void EEPROMManager::begin() {
     EEPROM.begin(EEPROM_SIZE);
 }
@@ -20,59 +130,46 @@ void EEPROMManager::begin() {
 bool EEPROMManager::saveConfig() {
     EEPROMHeader header = {
         .magic = CONFIG_MAGIC,
-        .version = getParamUint8(PARAM_VERSION),
-        .checksum = 0
+        .version = CONFIG_VERSION,
+        .checksum = FNV1A_SEED,
+        .length = 0,
+        .count = 0
     };
     
-    // Calculate checksum (упрощенный но корректный)
-    uint32_t checksum = 0;
+    int addr = sizeof(EEPROMHeader);
     for (int i = 0; i < PARAM_COUNT; i++) {
-        if (shouldSaveParam(system_params[i])) {
-            // Checksum для разных типов данных
-            switch(system_params[i].type) {
-                case TYPE_FLOAT:
-                    checksum += (uint32_t)(system_params[i].number.value * 1000); // float to int
-                    break;
-                case TYPE_UINT8:
-                    checksum += system_params[i].uint8.value;
-                    break;
-                case TYPE_UINT16:
-                    checksum += system_params[i].uint16.value;
-                    break;
-                case TYPE_INT16:
-                    checksum += system_params[i].int16.value;
-                    break;
-                case TYPE_BOOL:
-                    checksum += system_params[i].boolean.value ? 1 : 0;
-                    break;
-                case TYPE_STRING:
-                    // Для строк считаем хеш первых нескольких символов
-                    for (int j = 0; j < 8 && system_params[i].string.value[j] != '\0'; j++) {
-                        checksum += system_params[i].string.value[j];
-                    }
-                    break;
-            }
-            checksum += i; // Добавляем индекс для уникальности
+        if (!shouldSaveParam(system_params[i])) continue;
+        
+        const ConfigParam& param = system_params[i];
+        const ParamCodec& codec = codecFor(param);
+        ParamValue value;
+        uint8_t record[RECORD_HEADER_SIZE + RECORD_MAX_PAYLOAD];
+        
+        codec.load(param, value);
+        size_t len = codec.serialize(param, value, record + RECORD_HEADER_SIZE, RECORD_MAX_PAYLOAD);
+        record[0] = i & 0xFF;
+        record[1] = i >> 8;
+        record[2] = len;
+        
+        size_t total = RECORD_HEADER_SIZE + len;
+        if (addr + total > EEPROM_SIZE) {
+            Serial.printf("EEPROM full at %s, save aborted\n", param.name);
+            return false;
         }
+        for (size_t j = 0; j < total; j++) {
+            EEPROM.write(addr + j, record[j]);
+            header.checksum = fnv1a(header.checksum, record[j]);
+        }
+        addr += total;
+        header.count++;
     }
-    header.checksum = checksum;
+    header.length = addr - sizeof(EEPROMHeader);
     
-    // Save header
     EEPROM.put(0, header);
     
-    // Save parameters - ВСЕ которые должны сохраняться
-    int addr = sizeof(EEPROMHeader);
-    for (int i = 0; i < PARAM_COUNT; i++) {
-        if (shouldSaveParam(system_params[i])) {
-            EEPROM.put(addr, system_params[i]);
-            addr += sizeof(ConfigParam);
-            
-            Serial.printf("Saved: %s to addr %d\n", system_params[i].name, addr - sizeof(ConfigParam));
-        }
-    }
-    
     bool result = EEPROM.commit();
-    Serial.printf("EEPROM save %s, checksum: %lu\n", result ? "OK" : "FAILED", checksum);
+    Serial.printf("EEPROM save %s: %u params, %u bytes, checksum: %08lx\n", 
+                  result ? "OK" : "FAILED", header.count, header.length, header.checksum);
     return result;
 }
 
@@ -80,104 +177,121 @@ bool EEPROMManager::loadConfig() {
     EEPROMHeader header;
     EEPROM.get(0, header);
     
-    Serial.printf("EEPROM header: magic=0x%08lX, version=%lu, checksum=%lu\n", 
-                  header.magic, header.version, header.checksum);
+    Serial.printf("EEPROM header: magic=0x%08lX, version=%lu, length=%u\n", 
+                  header.magic, header.version, header.length);
+    
+    if (header.magic == LEGACY_CONFIG_MAGIC) {
+        if (!loadLegacyConfig()) return false;
+        saveConfig();   // Rewrite as records; the old layout is not read again
+        return true;
+    }
     
-    if (header.magic != CONFIG_MAGIC) {
+    if (header.magic != CONFIG_MAGIC || header.length > EEPROM_SIZE - sizeof(EEPROMHeader)) {
         Serial.println("No valid config found, using defaults");
         return false;
     }
     
-    // Verify checksum
-    uint32_t currentChecksum = 0;
-    int addr = sizeof(EEPROMHeader);
+    // Record indices keep their meaning within a config version; a newer
+    // version may have renumbered them
+    if (header.version > CONFIG_VERSION) {
+        Serial.printf("Config version %lu is newer than this firmware (%d), using defaults\n",
+                      header.version, CONFIG_VERSION);
+        return false;
+    }
     
-    // First pass: calculate checksum и найти адреса
-    for (int i = 0; i < PARAM_COUNT; i++) {
-        if (shouldSaveParam(system_params[i])) {
-            ConfigParam storedParam;
-            EEPROM.get(addr, storedParam);
-            
-            // Checksum как в saveConfig()
-            switch(storedParam.type) {
-                case TYPE_FLOAT:
-                    currentChecksum += (uint32_t)(storedParam.number.value * 1000);
-                    break;
-                case TYPE_UINT8:
-                    currentChecksum += storedParam.uint8.value;
-                    break;
-                case TYPE_UINT16:
-                    currentChecksum += storedParam.uint16.value;
-                    break;
-                case TYPE_INT16:
-                    currentChecksum += storedParam.int16.value;
-                    break;
-                
-                case TYPE_BOOL:
-                    currentChecksum += storedParam.boolean.value ? 1 : 0;
-                    break;
-                case TYPE_STRING:
-                    for (int j = 0; j < 8 && storedParam.string.value[j] != '\0'; j++) {
-                        currentChecksum += storedParam.string.value[j];
-                    }
-                    break;
-            }
-            currentChecksum += i;
-            
-            addr += sizeof(ConfigParam);
+    // Verify the whole record area before applying anything
+    const int start = sizeof(EEPROMHeader);
+    const int end = start + header.length;
+    uint32_t checksum = FNV1A_SEED;
+    for (int addr = start; addr < end; addr++) {
+        checksum = fnv1a(checksum, EEPROM.read(addr));
+    }
+    
+    if (checksum != header.checksum) {
+        Serial.printf("Checksum mismatch: stored=%08lx, calculated=%08lx\n", 
+                      header.checksum, checksum);
+        return false;
+    }
+    
+    int loaded = 0;
+    int skipped = 0;
+    int addr = start;
+    while (addr + RECORD_HEADER_SIZE <= end) {
+        uint16_t index = EEPROM.read(addr) | (EEPROM.read(addr + 1) << 8);
+        uint8_t len = EEPROM.read(addr + 2);
+        addr += RECORD_HEADER_SIZE;
+        if (addr + len > end) break;
+        
+        uint8_t payload[RECORD_MAX_PAYLOAD];
+        for (int j = 0; j < len; j++) {
+            payload[j] = EEPROM.read(addr + j);
+        }
+        addr += len;
+        
+        if (index >= PARAM_COUNT || !shouldSaveParam(system_params[index])) {
+            skipped++;
+            continue;
         }
+        
+        // Values that no longer decode or fit the current limits keep their default
+        const ConfigParam& param = system_params[index];
+        const ParamCodec& codec = codecFor(param);
+        ParamValue value;
+        if (!codec.deserialize(param, payload, len, value) || codec.validate(param, value)) {
+            Serial.printf("Stored %s rejected, keeping default\n", param.name);
+            skipped++;
+            continue;
+        }
+        setParamValue(static_cast<ParamIndex>(index), value);
+        loaded++;
+    }
+    
+    Serial.printf("Config loaded from EEPROM: %d params, %d skipped\n", loaded, skipped);
+    return true;
+}
+
+bool EEPROMManager::loadLegacyConfig() {
+    uint32_t storedChecksum;
+    EEPROM.get(8, storedChecksum);
+    
+    // Verify everything before applying anything, as loadConfig() does
+    uint32_t checksum = 0;
+    int addr = LEGACY_HEADER_SIZE;
+    for (size_t i = 0; i < LEGACY_PARAM_COUNT; i++, addr += LEGACY_RECORD_SIZE) {
+        ParamValue value;
+        if (!readLegacyValue(addr, system_params[legacyParams[i].param].type, value)) {
+            Serial.printf("Old config: unexpected type for %s, using defaults\n",
+                          system_params[legacyParams[i].param].name);
+            return false;
+        }
+        checksum += legacyChecksum(system_params[legacyParams[i].param].type, value);
+        checksum += legacyParams[i].index;
     }
     
-    if (currentChecksum != header.checksum) {
-        Serial.printf("Checksum mismatch: stored=%lu, calculated=%lu\n", 
-                      header.checksum, currentChecksum);
+    if (checksum != storedChecksum) {
+        Serial.printf("Old config checksum mismatch: stored=%lu, calculated=%lu\n",
+                      storedChecksum, checksum);
         return false;
     }
     
-    // Second pass: load parameters
-    addr = sizeof(EEPROMHeader);
-    for (int i = 0; i < PARAM_COUNT; i++) {
-        if (shouldSaveParam(system_params[i])) {
-            ConfigParam storedParam;
-            EEPROM.get(addr, storedParam);
-            
-            // Copy value to current parameter
-            switch (system_params[i].type) {
-                case TYPE_FLOAT:
-                    system_params[i].number.value = storedParam.number.value;
-                    break;
-                case TYPE_UINT8:
-                    system_params[i].uint8.value = storedParam.uint8.value;
-                    break;
-                case TYPE_UINT16:
-                    system_params[i].uint16.value = storedParam.uint16.value;
-                    break;
-                case TYPE_INT16:
-                    system_params[i].int16.value = storedParam.int16.value;
-                    break;
-                case TYPE_BOOL:
-                    system_params[i].boolean.value = storedParam.boolean.value;
-                    break;
-                case TYPE_STRING:
-                    strncpy(system_params[i].string.value, storedParam.string.value, 
-                            system_params[i].string.max_size);
-                    system_params[i].string.value[system_params[i].string.max_size - 1] = '\0';
-                    break;
-            }
-            
-            Serial.printf("Loaded: %s = ", system_params[i].name);
-            switch (system_params[i].type) {
-                case TYPE_FLOAT: Serial.println(system_params[i].number.value); break;
-                case TYPE_UINT8: Serial.println(system_params[i].uint8.value); break;
-                case TYPE_BOOL: Serial.println(system_params[i].boolean.value ? "true" : "false"); break;
-                default: Serial.println("..."); break;
-            }
-            
-            addr += sizeof(ConfigParam);
+    int loaded = 0;
+    int skipped = 0;
+    addr = LEGACY_HEADER_SIZE;
+    for (size_t i = 0; i < LEGACY_PARAM_COUNT; i++, addr += LEGACY_RECORD_SIZE) {
+        const ConfigParam& param = system_params[legacyParams[i].param];
+        const ParamCodec& codec = codecFor(param);
+        ParamValue value;
+        readLegacyValue(addr, param.type, value);
+        if (!shouldSaveParam(param) || codec.validate(param, value)) {
+            Serial.printf("Old %s not migrated, keeping default\n", param.name);
+            skipped++;
+            continue;
         }
+        setParamValue(legacyParams[i].param, value);
+        loaded++;
     }
     
-    Serial.println("Config loaded successfully from EEPROM");
+    Serial.printf("Config migrated from the old EEPROM layout: %d params, %d skipped\n", loaded, skipped);
     return true;
 }
 
@@ -187,27 +301,8 @@ bool EEPROMManager::shouldSaveParam(const ConfigParam& param) {
 
 void EEPROMManager::resetToDefaults() {
     for (int i = 0; i < PARAM_COUNT; i++) {
-        switch (system_params[i].type) {
-            case TYPE_FLOAT:
-                system_params[i].number.value = system_params[i].number.default_value;
-                break;
-            case TYPE_UINT8:
-                system_params[i].uint8.value = system_params[i].uint8.default_value;
-                break;
-            case TYPE_UINT16:
-                system_params[i].uint16.value = system_params[i].uint16.default_value;
-                break;
-            case TYPE_INT16:
-                system_params[i].int16.value = system_params[i].int16.default_value;
-                break;
-            case TYPE_BOOL:
-                system_params[i].boolean.value = system_params[i].boolean.default_value;
-                break;
-            case TYPE_STRING:
-                strncpy(system_params[i].string.value, system_params[i].string.default_value, 
-                        system_params[i].string.max_size);
-                system_params[i].string.value[system_params[i].string.max_size - 1] = '\0';
-                break;
-        }
+        ParamValue value;
+        codecFor(system_params[i]).loadDefault(system_params[i], value);
+        setParamValue(static_cast<ParamIndex>(i), value);
     }
-}
\ No newline at end of file
+}
@@ -13,6 +13,7 @@ public:
     
 private:
     bool shouldSaveParam(const ConfigParam& param);
+    bool loadLegacyConfig();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "Energy_Meter.h"
+#include "BurstFireDimmer.h"
+
+#define DUTY_WINDOW_1M   60000.0f
+#define DUTY_WINDOW_1H   3600000.0f
+#define DUTY_WINDOW_24H  86400000.0f
+
+EnergyMeter::EnergyMeter(BurstFireDimmer* dimmer) {
+  _dimmer = dimmer;
+  _lastFired = 0;
+  _lastTotal = 0;
+  _lastUpdate = 0;
+  _totalWh = 0;
+  _batchWh = 0;
+  _batchFullPowerHours = 0;
+  _batchFired = 0;
+  _batchTotal = 0;
+  _duty1m = 0;
+  _duty1h = 0;
+  _duty24h = 0;
+}
+
+void EnergyMeter::begin() {
+  _lastFired = _dimmer->getFiredHalfWaves();
+  _lastTotal = _dimmer->getTotalHalfWaves();
+  _lastUpdate = millis();
+  publish();
+}
+
+void EnergyMeter::update() {
+  unsigned long now = millis();
+  unsigned long elapsed = now - _lastUpdate;
+  if (elapsed == 0) return;
+  _lastUpdate = now;
+
+  // Read fired first: the ISR bumps fired before total, so a half-wave
+  // counted in between only shows up in total this round (as unfired) and
+  // its fired count is picked up on the next - firedDelta <= totalDelta
+  uint32_t fired = _dimmer->getFiredHalfWaves();
+  uint32_t total = _dimmer->getTotalHalfWaves();
+  uint32_t firedDelta = fired - _lastFired;
+  uint32_t totalDelta = total - _lastTotal;
+  _lastFired = fired;
+  _lastTotal = total;
+
+  // No zero-crossings seen means the triac could not have fired
+  float duty = 0;
+  if (totalDelta > 0) {
+    duty = (float)firedDelta / (float)totalDelta;
+    if (duty > 1.0f) duty = 1.0f;
+  }
+
+  _batchFired += firedDelta;
+  _batchTotal += totalDelta;
+
+  double hours = elapsed / 3600000.0;
+  double wh = getParamFloat(PARAM_HEATER_WATTAGE) * duty * hours;
+  _totalWh += wh;
+  _batchWh += wh;
+  _batchFullPowerHours += duty * hours;
+
+  // EMA with alpha = dt / window approximates a sliding window average
+  // at constant memory regardless of the update interval
+  _duty1m  += (duty - _duty1m)  * min(1.0f, elapsed / DUTY_WINDOW_1M);
+  _duty1h  += (duty - _duty1h)  * min(1.0f, elapsed / DUTY_WINDOW_1H);
+  _duty24h += (duty - _duty24h) * min(1.0f, elapsed / DUTY_WINDOW_24H);
+
+  publish();
+}
+
+void EnergyMeter::resetBatch() {
+  _batchWh = 0;
+  _batchFullPowerHours = 0;
+  _batchFired = 0;
+  _batchTotal = 0;
+  publish();
+}
+
+void EnergyMeter::publish() {
+  setParamFloat(PARAM_ENERGY_TOTAL, _totalWh);
+  setParamFloat(PARAM_ENERGY_BATCH, _batchWh);
+  setParamFloat(PARAM_BATCH_HEATER_HOURS, _batchFullPowerHours);
+  setParamFloat(PARAM_DUTY_1M, _duty1m * 100.0f);
+  setParamFloat(PARAM_DUTY_1H, _duty1h * 100.0f);
+  setParamFloat(PARAM_DUTY_24H, _duty24h * 100.0f);
+}
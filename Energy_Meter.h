@@ -0,0 +1,52 @@
+#ifndef ENERGY_METER_H
+#define ENERGY_METER_H
+
+#include <Arduino.h>
+#include "Param_helpers.h"
+
+// Forward declaration
+class BurstFireDimmer;
+
+// Rolls the dimmer's ISR half-wave counters up into energy and
+// duty-cycle figures. Runs in loop() context only, never in the ISR.
+class EnergyMeter {
+  public:
+    EnergyMeter(BurstFireDimmer* dimmer);
+
+    // Initialize the meter - call in setup() after the dimmer
+    void begin();
+
+    // Roll up the counters since the last call and publish the params
+    void update();
+
+    // Start a new batch (zeroes the per-batch totals)
+    void resetBatch();
+
+    // Half-wave counts since the last batch reset
+    uint32_t getBatchFiredHalfWaves() const { return _batchFired; }
+    uint32_t getBatchTotalHalfWaves() const { return _batchTotal; }
+
+  private:
+    BurstFireDimmer* _dimmer;
+
+    // Last seen ISR counter values (deltas survive wrap-around)
+    uint32_t _lastFired;
+    uint32_t _lastTotal;
+    unsigned long _lastUpdate;
+
+    // Accumulators kept in double, published to float params
+    double _totalWh;
+    double _batchWh;
+    double _batchFullPowerHours;
+    uint32_t _batchFired;
+    uint32_t _batchTotal;
+
+    // Exponentially weighted duty-cycle averages (0..1)
+    float _duty1m;
+    float _duty1h;
+    float _duty24h;
+
+    void publish();
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "Event_Stream.h"
+#include "HTTPS_Module.h"
+#include "Json_Stream.h"
+#include "Param_codec.h"
+
+#define SSE_CHUNK_HEADER_SIZE 8   // "%x\r\n" for a chunk shorter than 64 KB
+
+EventStream::EventStream()
+    : _server(nullptr), _timer(nullptr), _count(0), _workQueued(false), _eventLen(0) {
+    for (uint8_t i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+        _subs[i].sockfd = -1;
+    }
+}
+
+bool EventStream::begin(httpd_handle_t server) {
+    _server = server;
+
+    size_t worstCase = maxEventSize();
+    if (worstCase > SSE_EVENT_BUFFER_SIZE) {
+        Serial.printf("SSE: full snapshot needs up to %u bytes, SSE_EVENT_BUFFER_SIZE is %d - stream disabled\n",
+                      (unsigned)worstCase, SSE_EVENT_BUFFER_SIZE);
+        return false;
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = timerCallback;
+    args.arg = this;
+    args.name = "sse";
+    if (esp_timer_create(&args, &_timer) != ESP_OK) {
+        Serial.println("SSE: failed to create timer");
+        return false;
+    }
+    esp_timer_start_periodic(_timer, SSE_TICK_MS * 1000ULL);
+    return true;
+}
+
+esp_err_t EventStream::subscribe(httpd_req_t* req) {
+    Subscriber* slot = nullptr;
+    for (uint8_t i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+        if (_subs[i].sockfd < 0) {
+            slot = &_subs[i];
+            break;
+        }
+    }
+    if (!_timer) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_sendstr(req, "{\"error\":\"Stream unavailable\"}");
+        return ESP_OK;
+    }
+    if (!slot) {
+        // Keep sockets free for ordinary API requests
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_sendstr(req, "{\"error\":\"Too many stream subscribers\"}");
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, "text/event-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+
+    // First event is a full snapshot; sent through the request so the
+    // server emits the headers and switches to chunked encoding
+    uint32_t generation = getParamGeneration();
+    if (buildEvent(0, generation) < 0 ||
+        httpd_resp_send_chunk(req, _event + SSE_CHUNK_HEADER_SIZE, _eventLen) != ESP_OK) {
+        return ESP_FAIL;
+    }
+
+    slot->sockfd = httpd_req_to_sockfd(req);
+    slot->lastGen = generation;
+    slot->lastSent = millis();
+    _count++;
+
+    Serial.printf("SSE: subscriber on socket %d (%d/%d)\n", slot->sockfd, _count, SSE_MAX_SUBSCRIBERS);
+
+    // Return without the terminating chunk: the response stays open
+    return ESP_OK;
+}
+
+void EventStream::onClose(int sockfd) {
+    for (uint8_t i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+        if (_subs[i].sockfd == sockfd) {
+            _subs[i].sockfd = -1;
+            _count--;
+            Serial.printf("SSE: socket %d closed\n", sockfd);
+        }
+    }
+}
+
+// esp_timer task: only decides whether the httpd task has anything to do
+void EventStream::timerCallback(void* arg) {
+    EventStream* self = (EventStream*)arg;
+    if (self->_count == 0 || self->_workQueued) return;
+
+    self->_workQueued = true;
+    if (httpd_queue_work(self->_server, pushWork, self) != ESP_OK) {
+        self->_workQueued = false;
+    }
+}
+
+void EventStream::pushWork(void* arg) {
+    EventStream* self = (EventStream*)arg;
+    self->push();
+    self->_workQueued = false;
+}
+
+// httpd task: send each subscriber whatever changed since its last event
+void EventStream::push() {
+    unsigned long now = millis();
+    unsigned long interval = getParamUint16(PARAM_STREAM_INTERVAL);
+    uint32_t generation = getParamGeneration();
+
+    for (uint8_t i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+        Subscriber& sub = _subs[i];
+        if (sub.sockfd < 0) continue;
+        if (now - sub.lastSent < interval) continue;   // Coalesce
+
+        if (generation != sub.lastGen) {
+            int fields = buildEvent(sub.lastGen, generation);
+            if (fields < 0) {
+                // Cannot happen while begin()'s size check holds; never leave
+                // a subscriber silently stuck on an event that cannot be sent
+                Serial.printf("SSE: event overflow, dropping socket %d\n", sub.sockfd);
+                drop(sub);
+                continue;
+            }
+            if (fields > 0) {
+                if (!sendChunk(sub.sockfd, _event + SSE_CHUNK_HEADER_SIZE, _eventLen)) {
+                    drop(sub);
+                    continue;
+                }
+                sub.lastSent = now;
+            }
+            sub.lastGen = generation;   // Nothing streamable changed: just catch up
+        } else if (now - sub.lastSent >= SSE_KEEPALIVE_MS) {
+            static const char keepAlive[] = ": keep-alive\n\n";
+            if (!sendChunk(sub.sockfd, keepAlive, sizeof(keepAlive) - 1)) {
+                drop(sub);
+                continue;
+            }
+            sub.lastSent = now;
+        }
+    }
+}
+
+// Format "data: {...}\n\n" with the STREAM_ACCESS params changed after
+// 'since' (all of them when since is 0). Returns the number of params
+// written, or -1 if the event does not fit the buffer.
+int EventStream::buildEvent(uint32_t since, uint32_t generation) {
+    static const char prefix[] = "data: ";
+    memcpy(_event + SSE_CHUNK_HEADER_SIZE, prefix, sizeof(prefix) - 1);
+    _eventLen = sizeof(prefix) - 1;
+
+    JsonStreamWriter json(appendFlush, this);
+    json.beginObject();
+    json.key("gen");
+    json.valueUint(generation);
+
+    uint8_t fields = 0;
+    ParamList stream = getParamList(PARAM_LIST_STREAM);
+    for (uint8_t i = 0; i < stream.count; i++) {
+        const ConfigParam& param = system_params[stream[i]];
+        if (since != 0 && getParamChangedGen(stream[i]) <= since) continue;
+
+        json.key(param.name);
+        HTTPSModule::writeParamValue(json, param);
+        fields++;
+    }
+    json.endObject();
+    if (!json.finish()) return -1;
+
+    static const char suffix[] = "\n\n";
+    if (!appendFlush(this, suffix, sizeof(suffix) - 1)) return -1;
+
+    return fields;
+}
+
+// Upper bound of buildEvent(0, ...) in _event, chunk framing included:
+// every STREAM_ACCESS param at its longest raw text
+size_t EventStream::maxEventSize() {
+    size_t size = SSE_CHUNK_HEADER_SIZE + strlen("data: {\"gen\":4294967295}\n\n") + 2;
+    ParamList stream = getParamList(PARAM_LIST_STREAM);
+    for (uint8_t i = 0; i < stream.count; i++) {
+        const ConfigParam& param = system_params[stream[i]];
+        size += strlen(param.name) + 4;   // ,"name":
+        if (param.flags & SECURED_VALUE) {
+            size += 2 + 6 * (PARAM_TEXT_SIZE - 1);
+            continue;
+        }
+        switch (param.type) {
+            case TYPE_FLOAT:  size += 13; break;   // "%.7g": -1.234567e+38
+            case TYPE_UINT8:  size += 3; break;
+            case TYPE_UINT16: size += 5; break;
+            case TYPE_INT16:  size += 6; break;
+            case TYPE_BOOL:   size += 5; break;
+            case TYPE_STRING: size += 2 + 6 * (param.string.max_size - 1); break;   // \u00XX escapes
+        }
+    }
+    return size;
+}
+
+bool EventStream::appendFlush(void* ctx, const char* data, size_t len) {
+    EventStream* self = (EventStream*)ctx;
+    if (SSE_CHUNK_HEADER_SIZE + self->_eventLen + len + 2 > SSE_EVENT_BUFFER_SIZE) {
+        return false;
+    }
+    memcpy(self->_event + SSE_CHUNK_HEADER_SIZE + self->_eventLen, data, len);
+    self->_eventLen += len;
+    return true;
+}
+
+// Frame data as one HTTP chunk and write it in a single socket send.
+// 'data' may already sit in _event just after the reserved header space.
+bool EventStream::sendChunk(int sockfd, const char* data, size_t len) {
+    char header[SSE_CHUNK_HEADER_SIZE + 1];
+    int headerLen = snprintf(header, sizeof(header), "%x\r\n", (unsigned)len);
+
+    char* frame = _event + SSE_CHUNK_HEADER_SIZE - headerLen;
+    if (data != _event + SSE_CHUNK_HEADER_SIZE) {
+        if (len > SSE_EVENT_BUFFER_SIZE - SSE_CHUNK_HEADER_SIZE - 2) return false;
+        memcpy(_event + SSE_CHUNK_HEADER_SIZE, data, len);
+    }
+    memcpy(frame, header, headerLen);
+    memcpy(_event + SSE_CHUNK_HEADER_SIZE + len, "\r\n", 2);
+
+    size_t total = headerLen + len + 2;
+    return httpd_socket_send(_server, sockfd, frame, total, 0) == (int)total;
+}
+
+void EventStream::drop(Subscriber& sub) {
+    // The close callback frees the slot
+    httpd_sess_trigger_close(_server, sub.sockfd);
+}
@@ -0,0 +1,65 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <Arduino.h>
+#include <esp_https_server.h>
+#include <esp_timer.h>
+#include "Config.h"
+#include "Param_helpers.h"
+
+#define SSE_TICK_MS            100    // Base timer tick; coalescing is a multiple of it
+#define SSE_KEEPALIVE_MS       15000  // Comment line on idle streams keeps proxies open
+#define SSE_EVENT_BUFFER_SIZE  512    // One event (all STREAM_ACCESS params) must fit
+
+// Server-Sent Events push for /api/stream. Subscribers are sockets of the
+// HTTPS server whose handler returned with the chunked response left open.
+// A periodic esp_timer queues work onto the httpd task, which sends every
+// subscriber the STREAM_ACCESS params changed since its last event. The
+// control loop never touches this: change detection uses the parameter
+// generation counters only.
+class EventStream {
+  public:
+    EventStream();
+
+    // Start the coalescing timer - call once the server is running.
+    // Fails (and /api/stream answers 503) if a full snapshot of the
+    // STREAM_ACCESS params could exceed SSE_EVENT_BUFFER_SIZE.
+    bool begin(httpd_handle_t server);
+
+    // GET /api/stream body (runs on the httpd task)
+    esp_err_t subscribe(httpd_req_t* req);
+
+    // Socket closed by the server (runs on the httpd task)
+    void onClose(int sockfd);
+
+    uint8_t getSubscriberCount() const { return _count; }
+
+  private:
+    struct Subscriber {
+        int sockfd;               // -1 = free slot
+        uint32_t lastGen;         // Generation covered by the last event
+        unsigned long lastSent;   // millis() of the last event or keep-alive
+    };
+
+    httpd_handle_t _server;
+    esp_timer_handle_t _timer;
+    Subscriber _subs[SSE_MAX_SUBSCRIBERS];
+    volatile uint8_t _count;
+    volatile bool _workQueued;
+
+    // Event assembly buffer (httpd task only); room for the chunk header
+    char _event[SSE_EVENT_BUFFER_SIZE];
+    size_t _eventLen;
+
+    static void timerCallback(void* arg);
+    static void pushWork(void* arg);
+    static bool appendFlush(void* ctx, const char* data, size_t len);
+
+    void push();
+    int buildEvent(uint32_t since, uint32_t generation);
+    static size_t maxEventSize();
+    bool sendChunk(int sockfd, const char* data, size_t len);
+    void drop(Subscriber& sub);
+};
+
+#endif
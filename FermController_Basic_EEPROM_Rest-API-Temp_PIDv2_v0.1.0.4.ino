@@ -12,20 +12,33 @@ using std::min;
 
 // New parameter system
 #include "Param_types.h"
+#include "Param_access.h"
+#include "Param_bus.h"
+#include "Time_Service.h"
 //#include "param_config.cpp"
 //#include "Param_helpers.cpp"
 
 // Communication
 #include "Command_processor.h"
 #include "HTTPS_Module.h"
+#include "Request_Arena.h"
 
 // Controllers
 #include "PID_AutoTune_v2.h"
 #include "Temperature_Sensor.h"
+#include "Fixed_point.h"
+#include "Temp_Filter.h"
+#include "Temp_Estimator.h"
+#include "Sample_Scheduler.h"
 #include "BurstFireDimmer.h"
+#include "Energy_Meter.h"
 
 // Storage
 #include "EEPROM_Manager.h"
+#include <esp_heap_caps.h>
+
+// Controller input in fixed point with an explicit validity flag
+TempSample controlTemp = { 0, false };
 
 double currentTemp = 0;
 double setpoint = 0;
@@ -40,6 +53,10 @@ EEPROMManager eepromManager;
 BurstFireDimmer dimmer(ZERO_CROSS_PIN, TRIAC_PIN);
 PID_AutoTune_v2 pidController(&currentTemp, &pidOutput, &setpoint, &dimmer);
 Temperature_Sensor tempSensor(TEMP_SENSOR_PIN);
+EnergyMeter energyMeter(&dimmer);
+TempFilter tempFilter;
+TempEstimator tempEstimator;
+SampleScheduler sampleScheduler;
 
 
 // Global variables
@@ -50,6 +67,7 @@ unsigned long lastStatusPublish = 0;
 unsigned long previousTempMillis = 0;
 unsigned long previousPIDMillis = 0;
 unsigned long previousSaveMillis = 0;
+float loopTimeAverage = 0;
 
 void setup() {
     // Initialize serial communication
@@ -57,6 +75,9 @@ void setup() {
     Serial.println();
     Serial.println("=== Fermenter Controller Starting ===");
 
+    // String parameters get their arena slots before anything reads them
+    layoutParamStrings();
+
     //Setup NTP
     setupNTP();
     
@@ -69,12 +90,42 @@ void setup() {
         Serial.println("Configuration loaded from EEPROM");
     }
     
+    // Sorted name index and per-flag lists for the front ends
+    buildParamNameIndex();
+    buildParamLists();
+    if (!verifyParamAccessTypes()) {
+        // Typed accessors would read the wrong storage: do not run the heater
+        Serial.println("Typed parameter accessors disagree with param_config.cpp - halted");
+        while (true) delay(1000);
+    }
+
+    // Derived values are computed when a front end reads them
+    setParamGetter(PARAM_UPTIME, computeUptime);
+    setParamGetter(PARAM_HEAP_LARGEST_BLOCK, computeHeapLargestBlock);
+    setParamGetter(PARAM_HEAP_FREE, computeHeapFree);
+    setParamGetter(PARAM_WIFI_RSSI, computeWifiRssi);
+    setParamGetter(PARAM_TIME_TO_SETPOINT, computeTimeToSetpoint);
+    setParamGetter(PARAM_DISPLAY_I2C_BPS, computeDisplayI2cRate);
+    setParamGetter(PARAM_LOOP_TIME_US, computeLoopTime);
+    setParamGetter(PARAM_DISPLAY_RENDER_US, computeDisplayRenderTime);
+    setParamGetter(PARAM_DISPLAY_FLUSH_US, computeDisplayFlushTime);
+    setParamGetter(PARAM_TIME_SYNCED, computeTimeSynced);
+    setParamGetter(PARAM_API_REQUESTS, computeApiRequests);
+    setParamGetter(PARAM_API_CONNECTIONS, computeApiConnections);
+    setParamGetter(PARAM_ARENA_PEAK, computeArenaPeak);
+    setParamGetter(PARAM_ARENA_OVERFLOWS, computeArenaOverflows);
+
+    // Heater running state follows the power level
+    paramBus.subscribe(PARAM_POWER_LEVEL, onPowerLevelChanged);
+
     // Принудительно установить heater_enabled если он в RAM
     setParamBool(PARAM_HEATER_ENABLED, true);
 
     // Initialize hardware
     tempSensor.begin();  
+    pidController.SetEstimator(&tempEstimator);
     dimmer.begin();     
+    energyMeter.begin();
     
     // Initialize modules
     displayModule.begin();
@@ -98,53 +149,36 @@ void setup() {
 
 void loop() {
     unsigned long currentMillis = millis();
+    uint32_t loopStart = micros();
 
-    // Do every second: Read sensors, Update uptime
-    if (currentMillis - previousTempMillis >= getParamFloat(PARAM_UPDATE_INTERVAL)) {
-        setParamString(PARAM_UPTIME, getUptime());
-        updateHeaterStatus();
-        float temperatureReading = tempSensor.readTemperature();
-        if (temperatureReading != -127.0) {
-            setParamFloat(PARAM_CURRENT_TEMP, temperatureReading);
-        }
+    // Wall clock: non-blocking sync check, HH:MM refresh at minute rollover
+    timeService.update();
+
+    // Do every second: Update energy
+    if (currentMillis - previousTempMillis >= param<PARAM_UPDATE_INTERVAL>()) {
+        energyMeter.update();
         previousTempMillis = currentMillis;
     }
 
+    // Sensor reads follow the (optionally adaptive) sample schedule
+    if (sampleScheduler.due(currentMillis)) {
+        tempSensor.requestSample();
+    }
+
+    // Collect the sample once the broadcast conversion has finished
+    if (tempSensor.update()) {
+        controlTemp = tempFilter.process(tempSensor.getSample(PROBE_WORT));
+        if (controlTemp.valid) {
+            setParam<PARAM_CURRENT_TEMP>(tempFxToFloat(controlTemp.value));
+        }
+        tempEstimator.update(controlTemp, dimmer.getPower());
+        sampleScheduler.onSample(millis());
+    }
+
     // PID computation and power control
-    if (currentMillis - previousPIDMillis >= getParamFloat(PARAM_PID_SAMPLE_TIME)) {
-        float currentTemp = getParamFloat(PARAM_CURRENT_TEMP);
-        float setpoint = getParamFloat(PARAM_TEMP_SETPOINT);
-        
-        if (getParamUint8(PARAM_OPERATING_MODE) == 1) { // Auto mode
-            // Check if we should use PID or full power
-            if (fabs(setpoint - currentTemp) > getParamFloat(PARAM_PID_SWITCHING_DELTA)) {
-                // Outside PID range - use full power or off
-                if (currentTemp < setpoint) {
-                    setParamUint8(PARAM_POWER_LEVEL, (uint8_t)getParamFloat(PARAM_PID_MAX_POWER));
-                } else {
-                    setParamUint8(PARAM_POWER_LEVEL, 0);
-                }
-            } else {
-                // Within PID range - use simple power calculation based on temperature difference
-                float tempDifference = setpoint - currentTemp;
-                float maxPower = getParamFloat(PARAM_PID_MAX_POWER);
-                float minPower = getParamFloat(PARAM_PID_MIN_POWER);
-                float maxTempDiff = getParamFloat(PARAM_PID_MAX_TEMP_DIFF);
-                float minTempDiff = getParamFloat(PARAM_PID_MIN_TEMP_DIFF);
-                
-                if (tempDifference >= maxTempDiff) {
-                    setParamUint8(PARAM_POWER_LEVEL, (uint8_t)maxPower);
-                } else if (tempDifference <= minTempDiff) {
-                    setParamUint8(PARAM_POWER_LEVEL, (uint8_t)minPower);
-                } else {
-                    // Linear scaling between min and max
-                    float powerRange = maxPower - minPower;
-                    float tempRange = maxTempDiff - minTempDiff;
-                    float scale = (tempDifference - minTempDiff) / tempRange;
-                    float calculatedPower = minPower + (powerRange * scale);
-                    setParamUint8(PARAM_POWER_LEVEL, (uint8_t)calculatedPower);
-                }
-            }
+    if (currentMillis - previousPIDMillis >= param<PARAM_PID_SAMPLE_TIME>()) {
+        if (param<PARAM_OPERATING_MODE>() == 1) { // Auto mode
+            setParam<PARAM_POWER_LEVEL>(computeAutoPower(controllerInput()));
         }
         // In manual mode, powerLevel is set directly by user via commands
         
@@ -152,11 +186,11 @@ void loop() {
     }
 
     // Apply power to heater (with safety check)
-    if (getParamBool(PARAM_HEATER_ENABLED)) {
-        dimmer.setPower(getParamUint8(PARAM_POWER_LEVEL));
+    if (param<PARAM_HEATER_ENABLED>()) {
+        dimmer.setPower(param<PARAM_POWER_LEVEL>());
     } else {
         dimmer.setPower(0);
-        setParamUint8(PARAM_POWER_LEVEL, 0);
+        setParam<PARAM_POWER_LEVEL>(0);
     }
 
     // Process serial commands
@@ -167,8 +201,13 @@ void loop() {
     httpsModule.handleClient();
 
     rotaryModule.update();
+
+    // Deliver this pass's parameter changes before the display draws
+    paramBus.dispatch();
     displayModule.update();
 
+    recordLoopTime(micros() - loopStart);
+
     // Safety checks
     //float currentTemp = getParamFloat(PARAM_CURRENT_TEMP);
     //if (currentTemp > MAX_SAFE_TEMP) {
@@ -181,34 +220,86 @@ void loop() {
 }
 
 
+// Controller input: the filtered reading, or with the estimator enabled
+// the Kalman temperature projected pid_predict_horizon seconds ahead
+TempSample controllerInput() {
+    if (param<PARAM_KALMAN_ENABLED>() && tempEstimator.isValid() && controlTemp.valid) {
+        return tempEstimator.predict(param<PARAM_PID_PREDICT_HORIZON>());
+    }
+    return controlTemp;
+}
+
+// Auto-mode power level. Limits are converted from their float params once
+// per tick; the temperature math itself is integer only (1/128 °C units).
+uint8_t computeAutoPower(const TempSample& temp) {
+    // No valid reading: never heat blind
+    if (!temp.valid) {
+        return 0;
+    }
+
+    temp_fx_t error = tempFxFromFloat(param<PARAM_TEMP_SETPOINT>()) - temp.value;
+    int32_t maxPower = (int32_t)param<PARAM_PID_MAX_POWER>();
+    int32_t minPower = (int32_t)param<PARAM_PID_MIN_POWER>();
+
+    // Check if we should use PID or full power
+    if (abs(error) > tempFxFromFloat(param<PARAM_PID_SWITCHING_DELTA>())) {
+        // Outside PID range - use full power or off
+        return (error > 0) ? maxPower : 0;
+    }
+
+    // Within PID range - use simple power calculation based on temperature difference
+    temp_fx_t maxTempDiff = tempFxFromFloat(param<PARAM_PID_MAX_TEMP_DIFF>());
+    temp_fx_t minTempDiff = tempFxFromFloat(param<PARAM_PID_MIN_TEMP_DIFF>());
+
+    if (error >= maxTempDiff) {
+        return maxPower;
+    } else if (error <= minTempDiff) {
+        return minPower;
+    }
+
+    // Linear scaling between min and max
+    return minPower + (maxPower - minPower) * (error - minTempDiff) / (maxTempDiff - minTempDiff);
+}
+
 void showSystemStatus() {
     Serial.println("=== System Status ===");
     Serial.print("Mode: ");
-    Serial.println(getParamUint8(PARAM_OPERATING_MODE) == 1 ? "AUTO" : "MANUAL");
+    Serial.println(param<PARAM_OPERATING_MODE>() == 1 ? "AUTO" : "MANUAL");
     Serial.print("Temperature: ");
-    Serial.print(getParamFloat(PARAM_CURRENT_TEMP));
+    Serial.print(param<PARAM_CURRENT_TEMP>());
     Serial.println(" °C");
     Serial.print("Setpoint: ");
-    Serial.print(getParamFloat(PARAM_TEMP_SETPOINT));
+    Serial.print(param<PARAM_TEMP_SETPOINT>());
     Serial.println(" °C");
     Serial.print("Power Level: ");
-    Serial.print(getParamUint8(PARAM_POWER_LEVEL));
+    Serial.print(param<PARAM_POWER_LEVEL>());
     Serial.println(" %");
     Serial.print("Heater: ");
-    Serial.println(getParamBool(PARAM_HEATER_ENABLED) ? "ENABLED" : "DISABLED");
+    Serial.println(param<PARAM_HEATER_ENABLED>() ? "ENABLED" : "DISABLED");
     Serial.print("Heater Status: ");
-    Serial.println(getParamBool(PARAM_HEATER_RUNNING) ? "RUNNING" : "STOPPED");
+    Serial.println(param<PARAM_HEATER_RUNNING>() ? "RUNNING" : "STOPPED");
+    Serial.printf("Duty cycle: %.1f%% (1m) / %.1f%% (1h) / %.1f%% (24h)\n",
+                  param<PARAM_DUTY_1M>(),
+                  param<PARAM_DUTY_1H>(),
+                  param<PARAM_DUTY_24H>());
+    Serial.printf("Energy: %.2f Wh total, %.2f Wh this batch (%.2f h at full power)\n",
+                  param<PARAM_ENERGY_TOTAL>(),
+                  param<PARAM_ENERGY_BATCH>(),
+                  param<PARAM_BATCH_HEATER_HOURS>());
+    Serial.printf("Half-waves this batch: %lu fired / %lu total\n",
+                  (unsigned long)energyMeter.getBatchFiredHalfWaves(),
+                  (unsigned long)energyMeter.getBatchTotalHalfWaves());
     Serial.println("===================");
 }
 
 void checkSafetyLimits() {
-    float currentTemp = getParamFloat(PARAM_CURRENT_TEMP);
+    float currentTemp = param<PARAM_CURRENT_TEMP>();
     
     // Over-temperature protection
     if (currentTemp > MAX_SAFE_TEMP) {
         Serial.println("SAFETY: Over-temperature detected!");
-        setParamBool(PARAM_HEATER_ENABLED, false);
-        setParamUint8(PARAM_POWER_LEVEL, 0);
+        setParam<PARAM_HEATER_ENABLED>(false);
+        setParam<PARAM_POWER_LEVEL>(0);
     }
     
     // Under-temperature protection  
@@ -229,12 +320,12 @@ void setupWiFi() {
 bool connectToWiFi() {
   Serial.println("Connecting to WiFi...");
   
-  if (strlen(getParamString(PARAM_WIFI_SSID)) == 0) {
+  if (strlen(param<PARAM_WIFI_SSID>()) == 0) {
     Serial.println("No WiFi credentials configured.");
     return false;
   }
   
-  WiFi.begin(getParamString(PARAM_WIFI_SSID), getParamString(PARAM_WIFI_PASSWORD));
+  WiFi.begin(param<PARAM_WIFI_SSID>(), param<PARAM_WIFI_PASSWORD>());
   
   unsigned long startTime = millis();
   while (WiFi.status() != WL_CONNECTED && millis() - startTime < WIFI_TIMEOUT) {
@@ -274,32 +365,37 @@ void publishMQTTStatus() {
     // Only publish parameters with MQTT_ACCESS flag
 }
 
+// Param bus listener for PARAM_POWER_LEVEL
+void onPowerLevelChanged(ParamIndex index, uint32_t generation, void* ctx) {
+    updateHeaterStatus();
+}
+
 void updateHeaterStatus() {
-    uint8_t powerLevel = getParamUint8(PARAM_POWER_LEVEL);
+    uint8_t powerLevel = param<PARAM_POWER_LEVEL>();
     bool heaterRunning = (powerLevel > 0);
     
-    bool currentStatus = getParamBool(PARAM_HEATER_RUNNING);
+    bool currentStatus = param<PARAM_HEATER_RUNNING>();
     if (currentStatus != heaterRunning) {
-        setParamBool(PARAM_HEATER_RUNNING, heaterRunning);
+        setParam<PARAM_HEATER_RUNNING>(heaterRunning);
         Serial.printf("Heater %s (power=%d%%)\n", 
                      heaterRunning ? "STARTED" : "STOPPED", powerLevel);
     }
 }
 
 void setupNTP() {
-    const char* ntpServer = getParamString(PARAM_NTP_SERVER);
-    long gmtOffset_sec = (long)getParamInt16(PARAM_NTP_GMT_OFFSET) * 3600;
-    int daylightOffset_sec = (int)getParamInt16(PARAM_NTP_DAYLIGHT_OFFSET) * 3600;
+    const char* ntpServer = param<PARAM_NTP_SERVER>();
+    long gmtOffset_sec = (long)param<PARAM_NTP_GMT_OFFSET>() * 3600;
+    int daylightOffset_sec = (int)param<PARAM_NTP_DAYLIGHT_OFFSET>() * 3600;
     
     configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
     Serial.printf("NTP: %s, GMT: %dh, DST: %dh\n", 
                   ntpServer, 
-                  getParamInt16(PARAM_NTP_GMT_OFFSET),
-                  getParamInt16(PARAM_NTP_DAYLIGHT_OFFSET));
+                  param<PARAM_NTP_GMT_OFFSET>(),
+                  param<PARAM_NTP_DAYLIGHT_OFFSET>());
 }
 
-const char* getUptime() {
-  static char buffer[12]; // static чтобы память не очищалась
+// Getters of the COMPUTED parameters (run only when a front end reads them)
+void computeUptime(ParamValue& out) {
   unsigned long ms = millis();
   unsigned long seconds = ms / 1000;
   unsigned long days = seconds / 86400;
@@ -309,16 +405,87 @@ const char* getUptime() {
   unsigned long minutes = seconds / 60;
   seconds %= 60;
 
-  snprintf(buffer, sizeof(buffer), "%02lu:%02lu:%02lu:%02lu", days, hours, minutes, seconds);
-  return buffer;
+  snprintf(out.string, sizeof(out.string), "%02lu:%02lu:%02lu:%02lu", days, hours, minutes, seconds);
 }
 
-String getTimeHHMM() {
-  struct tm timeinfo;
-  if (!getLocalTime(&timeinfo)) {
-    return "00:00"; // fallback if time not available
+void computeHeapLargestBlock(ParamValue& out) {
+  out.number = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) / 1024.0f;
+}
+
+void computeHeapFree(ParamValue& out) {
+  out.number = heap_caps_get_free_size(MALLOC_CAP_8BIT) / 1024.0f;
+}
+
+void computeWifiRssi(ParamValue& out) {
+  out.int16 = (WiFi.status() == WL_CONNECTED) ? WiFi.RSSI() : 0;
+}
+
+void computeDisplayI2cRate(ParamValue& out) {
+  out.number = displayModule.getI2cBytesPerSecond();
+}
+
+void computeDisplayRenderTime(ParamValue& out) {
+  out.number = displayModule.getRenderUs();
+}
+
+void computeDisplayFlushTime(ParamValue& out) {
+  out.number = displayModule.getFlushUs();
+}
+
+void computeLoopTime(ParamValue& out) {
+  out.number = loopTimeAverage;
+}
+
+void computeTimeSynced(ParamValue& out) {
+  out.boolean = timeService.isSynced();
+}
+
+// Counted as uint32 by the HTTPS module; shown as float (exact to 2^24)
+void computeApiRequests(ParamValue& out) {
+  out.number = HTTPSModule::getRequestCount();
+}
+
+void computeApiConnections(ParamValue& out) {
+  out.number = HTTPSModule::getConnectionCount();
+}
+
+// Read from the arena's own counters so serving a request never bumps
+// the param generation (and with it every ETag)
+void computeArenaPeak(ParamValue& out) {
+  out.uint16 = RequestArena::getPeak();
+}
+
+void computeArenaOverflows(ParamValue& out) {
+  out.uint16 = RequestArena::getOverflows();
+}
+
+// Average loop() pass over one-second windows (loop_time_us)
+void recordLoopTime(uint32_t elapsedUs) {
+  static uint32_t windowSum = 0;
+  static uint32_t windowCount = 0;
+  static unsigned long windowStart = 0;
+
+  windowSum += elapsedUs;
+  windowCount++;
+  if (millis() - windowStart >= 1000) {
+    loopTimeAverage = (float)windowSum / windowCount;
+    windowSum = 0;
+    windowCount = 0;
+    windowStart = millis();
   }
-  char buffer[6];
-  strftime(buffer, sizeof(buffer), "%H:%M", &timeinfo);
-  return String(buffer);
-}
\ No newline at end of file
+}
+
+// Minutes until the estimated rate reaches the setpoint; -1 while the
+// temperature is flat or moving away from it
+void computeTimeToSetpoint(ParamValue& out) {
+  float gap = param<PARAM_TEMP_SETPOINT>() - param<PARAM_CURRENT_TEMP>();
+  float rate = param<PARAM_EST_RATE>();   // C/min
+
+  if (fabs(gap) < 0.05f) {
+    out.number = 0;
+  } else if (fabs(rate) < 0.001f || (gap > 0) != (rate > 0)) {
+    out.number = -1;
+  } else {
+    out.number = min(gap / rate, 100000.0f);
+  }
+}
@@ -0,0 +1,30 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <Arduino.h>
+
+// Fixed-point temperatures shared by the sensor path and the controller.
+// Values are signed 1/128 °C, the raw unit DallasTemperature::getTemp()
+// returns (DS18B20 1/16 °C counts << 3), so reading a probe involves no
+// float math and the extra bits keep filter state from truncating.
+typedef int32_t temp_fx_t;
+
+#define TEMP_FX_FRAC_BITS  7
+#define TEMP_FX_ONE        (1 << TEMP_FX_FRAC_BITS)
+
+// A temperature together with an explicit validity flag (replaces the
+// old -127.0 "disconnected" sentinel)
+struct TempSample {
+    temp_fx_t value;
+    bool valid;
+};
+
+inline temp_fx_t tempFxFromFloat(float celsius) {
+    return (temp_fx_t)lroundf(celsius * TEMP_FX_ONE);
+}
+
+inline float tempFxToFloat(temp_fx_t value) {
+    return (float)value / TEMP_FX_ONE;
+}
+
+#endif
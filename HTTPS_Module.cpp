@@ -1,5 +1,12 @@
 #include "HTTPS_Module.h"
 #include "cert.h"
+#include "BurstFireDimmer.h"
+#include "Config.h"
+#include "Request_Arena.h"
+#include "Param_codec.h"
+#include <lwip/sockets.h>
+
+extern BurstFireDimmer dimmer;
 
 HTTPSModule::HTTPSModule() {
     // Initialize URI structures
@@ -14,20 +21,75 @@ HTTPSModule::HTTPSModule() {
     config_uri.method = HTTP_GET;
     config_uri.handler = config_get_handler;
     config_uri.user_ctx = this;
+
+    memset(&dimmer_stats_uri, 0, sizeof(dimmer_stats_uri));
+    dimmer_stats_uri.uri      = "/api/dimmer_stats";
+    dimmer_stats_uri.method   = HTTP_GET;
+    dimmer_stats_uri.handler  = dimmer_stats_get_handler;
+    dimmer_stats_uri.user_ctx = this;
+
+    memset(&changes_uri, 0, sizeof(changes_uri));
+    changes_uri.uri      = "/api/changes";
+    changes_uri.method   = HTTP_GET;
+    changes_uri.handler  = changes_get_handler;
+    changes_uri.user_ctx = this;
+
+    memset(&stream_uri, 0, sizeof(stream_uri));
+    stream_uri.uri      = "/api/stream";
+    stream_uri.method   = HTTP_GET;
+    stream_uri.handler  = stream_get_handler;
+    stream_uri.user_ctx = this;
 }
 
 bool HTTPSModule::begin() {
     Serial.println("Initializing HTTPS API module...");
+    etagNonce = esp_random();
+    RequestArena::installHooks();
+
+#if SSL_USE_ECDSA_CERT
+    // P-256 handshakes cost a fraction of RSA-2048 on the ESP32
+    const char* cert = server_cert_ecdsa;
+    const char* key  = server_key_ecdsa;
+#else
+    const char* cert = server_cert;
+    const char* key  = server_key;
+#endif
 
     httpd_ssl_config_t conf = HTTPD_SSL_CONFIG_DEFAULT();
-    conf.servercert     = (const uint8_t*)server_cert;
-    conf.servercert_len = strlen_P(server_cert) + 1;
-    conf.prvtkey_pem    = (const uint8_t*)server_key;
-    conf.prvtkey_len    = strlen_P(server_key) + 1;
+    conf.servercert     = (const uint8_t*)cert;
+    conf.servercert_len = strlen_P(cert) + 1;
+    conf.prvtkey_pem    = (const uint8_t*)key;
+    conf.prvtkey_len    = strlen_P(key) + 1;
+    conf.httpd.close_fn = session_close;   // Drops event stream subscribers
+    conf.httpd.max_open_sockets = HTTP_MAX_CLIENTS;   // SSE_MAX_SUBSCRIBERS is derived from it
+
+    // Reuse connections instead of paying a handshake per request. The
+    // server keeps HTTP/1.1 connections open by itself; session tickets
+    // make the reconnects that do happen cheap. Only on cores built with
+    // ticket support: elsewhere enabling them makes httpd_ssl_start() fail.
+#if SSL_SESSION_TICKETS && defined(CONFIG_ESP_TLS_SERVER_SESSION_TICKETS)
+    conf.session_tickets = true;
+#endif
+    // TCP keep-alive probes, not HTTP persistence: they only detect and
+    // free sockets whose peer vanished (Wi-Fi dropped, client powered off)
+    conf.httpd.keep_alive_enable   = true;
+    conf.httpd.keep_alive_idle     = HTTP_KEEP_ALIVE_IDLE;
+    conf.httpd.keep_alive_interval = 5;
+    conf.httpd.keep_alive_count    = 3;
+    // New clients evict the least recently used socket when all are taken.
+    // Note that LRU age only moves on received requests, so an /api/stream
+    // socket (which only sends) is evicted first; EventSource clients
+    // reconnect on their own. Without purging, one browser holding
+    // persistent connections could lock everyone else out.
+    conf.httpd.lru_purge_enable    = true;
 
     if (httpd_ssl_start(&server, &conf) == ESP_OK) {
         httpd_register_uri_handler(server, &set_uri);
         httpd_register_uri_handler(server, &config_uri);
+        httpd_register_uri_handler(server, &dimmer_stats_uri);
+        httpd_register_uri_handler(server, &changes_uri);
+        httpd_register_uri_handler(server, &stream_uri);
+        eventStream.begin(server);
         Serial.println("HTTPS server started successfully");
         return true;
     } else {
@@ -36,6 +98,26 @@ bool HTTPSModule::begin() {
     }
 }
 
+// Session context marker; nothing to free
+static void session_ctx_free(void* ctx) {
+}
+
+std::atomic<uint32_t> HTTPSModule::requestCount(0);
+std::atomic<uint32_t> HTTPSModule::connectionCount(0);
+
+// Count requests and the connections they arrive on (called first by
+// every handler, authorized or not)
+void HTTPSModule::track_request(httpd_req_t *req) {
+    requestCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (req->sess_ctx == nullptr) {
+        // First request on this socket: a new TLS connection
+        req->sess_ctx = (void*)1;
+        req->free_ctx = session_ctx_free;
+        connectionCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 bool HTTPSModule::is_authorized(httpd_req_t *req) {
     char auth_header[150];
     if (httpd_req_get_hdr_value_str(req, "Authorization", auth_header, sizeof(auth_header)) == ESP_OK) {
@@ -53,150 +135,613 @@ void HTTPSModule::send_unauthorized(httpd_req_t *req) {
     httpd_resp_sendstr(req, "{\"error\":\"Unauthorized\"}");
 }
 
+// Write one parameter value (secured values are masked)
+void HTTPSModule::writeParamValue(JsonStreamWriter& json, const ConfigParam& param) {
+    char text[PARAM_TEXT_SIZE];
+    formatParam(paramIndexOf(param), PARAM_FORMAT_RAW, text, sizeof(text));
+
+    ParamTextKind kind = (param.flags & SECURED_VALUE) ? PARAM_TEXT_STRING : codecFor(param).textKind;
+    switch (kind) {
+        case PARAM_TEXT_NUMBER:
+            json.valueNumber(text);
+            break;
+        case PARAM_TEXT_BOOL:
+            json.valueBool(strcmp(text, "true") == 0);
+            break;
+        case PARAM_TEXT_STRING:
+            json.valueString(text);
+            break;
+    }
+}
+
+// Strong ETag for the parameter set at a given change generation
+void HTTPSModule::formatETag(char* buf, size_t size, uint32_t generation, const char* variant) {
+    snprintf(buf, size, "\"%08lx-%lu%s\"", (unsigned long)etagNonce, (unsigned long)generation, variant);
+}
+
+// Request header contains the given media type (Accept / Content-Type)
+bool HTTPSModule::header_has(httpd_req_t *req, const char* header, const char* mediaType) {
+    char value[64];
+    if (httpd_req_get_hdr_value_str(req, header, value, sizeof(value)) != ESP_OK) {
+        return false;
+    }
+    return strstr(value, mediaType) != nullptr;
+}
+
+// Write one parameter value as CBOR (secured values are masked)
+void HTTPSModule::writeParamValue(CborStreamWriter& cbor, const ConfigParam& param) {
+    if (param.flags & SECURED_VALUE) {
+        cbor.valueString("******");
+        return;
+    }
+
+    ParamValue value;
+    getParamValue(paramIndexOf(param), value);   // Runs the getter of a COMPUTED parameter
+
+    switch (param.type) {
+        case TYPE_FLOAT:
+            cbor.valueFloat(value.number);
+            break;
+        case TYPE_UINT8:
+            cbor.valueUint(value.uint8);
+            break;
+        case TYPE_UINT16:
+            cbor.valueUint(value.uint16);
+            break;
+        case TYPE_INT16:
+            cbor.valueInt(value.int16);
+            break;
+        case TYPE_BOOL:
+            cbor.valueBool(value.boolean);
+            break;
+        case TYPE_STRING:
+            cbor.valueString(value.string);
+            break;
+    }
+}
+
+// Flag groups for /api/config?group=; any other group name is a name prefix
+static const struct {
+    const char* name;
+    uint16_t flag;
+} API_FLAG_GROUPS[] = {
+    { "stream",   STREAM_ACCESS },
+    { "rotary",   ROTARY_ACCESS },
+    { "display",  DISPLAY_ACCESS },
+    { "mqtt",     MQTT_ACCESS },
+    { "influxdb", INFLUXDB_REPORT },
+    { "volatile", NO_FLASH_SAVE },
+    { "computed", COMPUTED },
+};
+
+// Default selection: stored API params in table order. COMPUTED values
+// (uptime, heap, RSSI, ...) are live readings; they are only returned
+// when asked for by ?fields= or ?group=, so the default document keeps
+// its ETag
+static void select_default(ParamIndex* out, size_t& count) {
+    ParamList api = getParamList(PARAM_LIST_API);
+    for (uint8_t i = 0; i < api.count; i++) {
+        if (!(system_params[api[i]].flags & COMPUTED)) out[count++] = api[i];
+    }
+}
+
+// Resolve ?fields=a,b,c or ?group=<flag group|name prefix> into the
+// params to return (API_ACCESS only). Without either, all stored API
+// params in table order. Returns false if the query is unusable.
+bool HTTPSModule::select_params(httpd_req_t *req, ParamIndex* out, size_t& count) {
+    count = 0;
+
+    size_t queryLen = httpd_req_get_url_query_len(req);
+    if (queryLen == 0) {
+        select_default(out, count);
+        return true;
+    }
+    if (queryLen >= API_MAX_QUERY_SIZE) return false;
+
+    char query[API_MAX_QUERY_SIZE];
+    char value[API_MAX_QUERY_SIZE];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) return false;
+
+    if (httpd_query_key_value(query, "fields", value, sizeof(value)) == ESP_OK) {
+        // One index lookup per requested name; unknown names are skipped
+        char* save = nullptr;
+        for (char* name = strtok_r(value, ",", &save); name; name = strtok_r(nullptr, ",", &save)) {
+            int index = findParamByName(name);
+            if (index >= 0 && (system_params[index].flags & API_ACCESS) && count < PARAM_COUNT) {
+                out[count++] = static_cast<ParamIndex>(index);
+            }
+        }
+        return true;
+    }
+
+    if (httpd_query_key_value(query, "group", value, sizeof(value)) == ESP_OK) {
+        ParamList api = getParamList(PARAM_LIST_API);
+        for (size_t g = 0; g < sizeof(API_FLAG_GROUPS) / sizeof(API_FLAG_GROUPS[0]); g++) {
+            if (strcmp(value, API_FLAG_GROUPS[g].name) == 0) {
+                for (uint8_t i = 0; i < api.count; i++) {
+                    if (system_params[api[i]].flags & API_FLAG_GROUPS[g].flag) out[count++] = api[i];
+                }
+                return true;
+            }
+        }
+
+        // Name prefix: a contiguous range of the sorted name index
+        size_t found = findParamsByPrefix(value, out, PARAM_COUNT);
+        for (size_t i = 0; i < found; i++) {
+            if (system_params[out[i]].flags & API_ACCESS) out[count++] = out[i];
+        }
+        return true;
+    }
+
+    // Unrelated query keys: behave as if there were none
+    select_default(out, count);
+    return true;
+}
+
 // GET /api/config - get all parameters with API_ACCESS flag
+// (optionally narrowed with ?fields= or ?group=)
 esp_err_t HTTPSModule::config_get_handler(httpd_req_t *req) {
     HTTPSModule* instance = (HTTPSModule*)req->user_ctx;
+    track_request(req);
     if (!instance->is_authorized(req)) {
         instance->send_unauthorized(req);
         return ESP_OK;
     }
 
-    cJSON *root = cJSON_CreateObject();
-    
-    // Add all parameters with API_ACCESS flag
-    for (int i = 0; i < PARAM_COUNT; i++) {
-        if (system_params[i].flags & API_ACCESS) {
-            if (system_params[i].flags & SECURED_VALUE) {
-                cJSON_AddStringToObject(root, system_params[i].name, "******");
-            } else {
-                switch (system_params[i].type) {
-                    case TYPE_FLOAT:
-                        cJSON_AddNumberToObject(root, system_params[i].name, system_params[i].number.value);
-                        break;
-                    case TYPE_UINT8:
-                        cJSON_AddNumberToObject(root, system_params[i].name, system_params[i].uint8.value);
-                        break;
-                    case TYPE_UINT16:
-                        cJSON_AddNumberToObject(root, system_params[i].name, system_params[i].uint16.value);
-                        break;
-                    case TYPE_BOOL:
-                        cJSON_AddBoolToObject(root, system_params[i].name, system_params[i].boolean.value);
-                        break;
-                    case TYPE_STRING:
-                        cJSON_AddStringToObject(root, system_params[i].name, system_params[i].string.value);
-                        break;
-                }
-            }
+    bool cbor = header_has(req, "Accept", "application/cbor");
+
+    ParamIndex selected[PARAM_COUNT];
+    size_t count;
+    if (!select_params(req, selected, count)) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Bad query");
+        return ESP_OK;
+    }
+
+    // COMPUTED values change without bumping the generation, so an
+    // explicit selection containing one gets no ETag
+    bool cacheable = true;
+    for (size_t i = 0; i < count && cacheable; i++) {
+        cacheable = !(system_params[selected[i]].flags & COMPUTED);
+    }
+    httpd_resp_set_hdr(req, "Vary", "Accept");
+
+    // Nothing changed since the client's copy: answer 304 with no body
+    char etag[32];
+    if (cacheable) {
+        instance->formatETag(etag, sizeof(etag), getParamGeneration(), cbor ? "-cbor" : "");
+        httpd_resp_set_hdr(req, "ETag", etag);
+
+        char ifNoneMatch[48];
+        if (httpd_req_get_hdr_value_str(req, "If-None-Match", ifNoneMatch, sizeof(ifNoneMatch)) == ESP_OK &&
+            strcmp(ifNoneMatch, etag) == 0) {
+            httpd_resp_set_status(req, "304 Not Modified");
+            httpd_resp_send(req, NULL, 0);
+            return ESP_OK;
+        }
+    }
+
+    if (cbor) {
+        // Compact form: map of param index -> native value
+        httpd_resp_set_type(req, "application/cbor");
+        CborStreamWriter out(JsonStreamWriter::httpdChunkFlush, req);
+        out.beginMap();
+        for (size_t i = 0; i < count; i++) {
+            out.valueUint(selected[i]);
+            writeParamValue(out, system_params[selected[i]]);
+        }
+        out.end();
+        out.finish();
+        httpd_resp_send_chunk(req, NULL, 0);
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+
+    // Stream each parameter straight into chunked output (no cJSON tree)
+    JsonStreamWriter json(JsonStreamWriter::httpdChunkFlush, req);
+    json.beginObject();
+    for (size_t i = 0; i < count; i++) {
+        json.key(system_params[selected[i]].name);
+        writeParamValue(json, system_params[selected[i]]);
+    }
+    json.endObject();
+    json.finish();
+
+    // Terminate the chunked response
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
+// GET /api/changes?since=<nonce>-<gen> - parameters changed after a generation
+esp_err_t HTTPSModule::changes_get_handler(httpd_req_t *req) {
+    HTTPSModule* instance = (HTTPSModule*)req->user_ctx;
+    track_request(req);
+    if (!instance->is_authorized(req)) {
+        instance->send_unauthorized(req);
+        return ESP_OK;
+    }
+
+    // since=<boot nonce>-<generation>, as returned in "since" last time
+    uint32_t since = 0;
+    bool sameBoot = false;
+    char query[48];
+    char sinceStr[24];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "since", sinceStr, sizeof(sinceStr)) == ESP_OK) {
+        char* end;
+        uint32_t nonce = strtoul(sinceStr, &end, 16);
+        if (*end == '-') {
+            since = strtoul(end + 1, nullptr, 10);
+            sameBoot = (nonce == instance->etagNonce);
         }
     }
 
+    uint32_t generation = getParamGeneration();
+
+    // No baseline, or one from before a reboot (generations restart at
+    // zero, so only the nonce tells): resend everything
+    bool full = (!sameBoot || since == 0 || since > generation);
+
+    char token[24];
+    snprintf(token, sizeof(token), "%08lx-%lu", (unsigned long)instance->etagNonce, (unsigned long)generation);
+
+    httpd_resp_set_type(req, "application/json");
+
+    JsonStreamWriter json(JsonStreamWriter::httpdChunkFlush, req);
+    json.beginObject();
+    json.key("generation");
+    json.valueUint(generation);
+    json.key("since");
+    json.valueString(token);
+    json.key("full");
+    json.valueBool(full);
+    json.key("params");
+    json.beginObject();
+    ParamList api = getParamList(PARAM_LIST_API);
+    for (uint8_t i = 0; i < api.count; i++) {
+        // COMPUTED values are not change tracked; see /api/config?group=computed
+        if (system_params[api[i]].flags & COMPUTED) continue;
+        if (full || getParamChangedGen(api[i]) > since) {
+            json.key(system_params[api[i]].name);
+            writeParamValue(json, system_params[api[i]]);
+        }
+    }
+    json.endObject();
+    json.endObject();
+    json.finish();
+
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
+// GET /api/stream - Server-Sent Events with STREAM_ACCESS params
+esp_err_t HTTPSModule::stream_get_handler(httpd_req_t *req) {
+    HTTPSModule* instance = (HTTPSModule*)req->user_ctx;
+    track_request(req);
+    if (!instance->is_authorized(req)) {
+        instance->send_unauthorized(req);
+        return ESP_OK;
+    }
+    return instance->eventStream.subscribe(req);
+}
+
+// Socket close hook; with close_fn set the server leaves close() to us
+void HTTPSModule::session_close(httpd_handle_t hd, int sockfd) {
+    httpsModule.eventStream.onClose(sockfd);
+    close(sockfd);
+}
+
+// GET /api/dimmer_stats - zero-cross ISR diagnostics
+esp_err_t HTTPSModule::dimmer_stats_get_handler(httpd_req_t *req) {
+    HTTPSModule* instance = (HTTPSModule*)req->user_ctx;
+    track_request(req);
+    if (!instance->is_authorized(req)) {
+        instance->send_unauthorized(req);
+        return ESP_OK;
+    }
+
+    BurstFireDimmer::Stats stats;
+    dimmer.getStats(stats);
+
+    // cJSON nodes and the printed string live in the request arena
+    ArenaScope arena;
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "valid_edges", stats.validEdges);
+    cJSON_AddNumberToObject(root, "noise_edges", stats.noiseEdges);
+    cJSON_AddNumberToObject(root, "missed_edges", stats.missedEdges);
+    cJSON_AddNumberToObject(root, "isr_time_last_us", stats.isrTimeLast);
+    cJSON_AddNumberToObject(root, "isr_time_avg_us", stats.isrTimeAvg);
+    cJSON_AddNumberToObject(root, "isr_time_max_us", stats.isrTimeMax);
+    cJSON_AddNumberToObject(root, "hist_bin_width_us", stats.histBinWidth);
+
+    cJSON *histogram = cJSON_AddArrayToObject(root, "edge_histogram");
+    for (uint8_t i = 0; i < BurstFireDimmer::EDGE_HIST_BINS; i++) {
+        cJSON_AddItemToArray(histogram, cJSON_CreateNumber(stats.edgeHistogram[i]));
+    }
+
     const char* response = cJSON_PrintUnformatted(root);
     httpd_resp_set_type(req, "application/json");
     httpd_resp_sendstr(req, response);
 
-    free((void*)response);
+    cJSON_free((void*)response);
     cJSON_Delete(root);
     return ESP_OK;
 }
 
+// Stage one key/value from the /api/set body as soon as it is parsed
+void HTTPSModule::applyJsonPair(void* ctx, const char* key, JsonValueKind kind, const char* text) {
+    SetRequestResult* result = (SetRequestResult*)ctx;
+
+    int index = findParamByName(key);
+    ConfigParam* found = (index >= 0 && (system_params[index].flags & API_ACCESS)) ? &system_params[index] : nullptr;
+
+    recordResult(*result, key, found ? stageParamValue(result->tx, *found, kind, text) : "unknown parameter");
+}
+
+// Stage one CBOR pair (param index -> native value) through the same
+// validation as JSON by rendering the value as JSON-style text
+void HTTPSModule::applyCborPair(SetRequestResult& result, const CborItem& key, const CborItem& value) {
+    if (key.kind != CBOR_ITEM_UINT || key.integer >= PARAM_COUNT ||
+        !(system_params[key.integer].flags & API_ACCESS)) {
+        char name[JSON_PARSER_KEY_SIZE];
+        snprintf(name, sizeof(name), "#%ld", key.kind == CBOR_ITEM_UINT ? (long)key.integer : -1L);
+        recordResult(result, name, "unknown parameter");
+        return;
+    }
+
+    ConfigParam& param = system_params[key.integer];
+    char text[JSON_PARSER_VALUE_SIZE];
+    JsonValueKind kind = JSON_VALUE_NUMBER;
+    switch (value.kind) {
+        case CBOR_ITEM_UINT:
+        case CBOR_ITEM_NEGINT:
+            snprintf(text, sizeof(text), "%lld", (long long)value.integer);
+            break;
+        case CBOR_ITEM_FLOAT:
+            snprintf(text, sizeof(text), "%.9g", value.number);
+            break;
+        case CBOR_ITEM_BOOL:
+            kind = JSON_VALUE_BOOL;
+            strcpy(text, value.boolean ? "true" : "false");
+            break;
+        case CBOR_ITEM_TEXT:
+            if (value.length >= sizeof(text)) {
+                kind = JSON_VALUE_OVERSIZE;
+                break;
+            }
+            kind = JSON_VALUE_STRING;
+            memcpy(text, value.text, value.length);
+            text[value.length] = '\0';
+            break;
+        case CBOR_ITEM_NULL:
+            kind = JSON_VALUE_NULL;
+            text[0] = '\0';
+            break;
+        default:
+            kind = JSON_VALUE_NESTED;
+            break;
+    }
+
+    recordResult(result, param.name, stageParamValue(result.tx, param, kind, text));
+}
+
+// Count a result; keep the first few failures for the response
+void HTTPSModule::recordResult(SetRequestResult& result, const char* key, const char* error) {
+    if (!error) {
+        result.successCount++;
+        return;
+    }
+
+    if (result.errorCount < API_MAX_KEY_ERRORS) {
+        KeyError& entry = result.keyErrors[result.errorCount];
+        strncpy(entry.key, key, sizeof(entry.key) - 1);
+        entry.key[sizeof(entry.key) - 1] = '\0';
+        entry.reason = error;
+    }
+    result.errorCount++;
+}
+
+// Type-check one value and stage it; returns nullptr or an error reason
+const char* HTTPSModule::stageParamValue(ParamTransaction& tx, ConfigParam& param, JsonValueKind kind, const char* text) {
+    if (kind == JSON_VALUE_OVERSIZE) return "too long";
+    if (kind == JSON_VALUE_NESTED) return "unsupported value";
+
+    // The JSON kind must match the codec's text form for the type
+    switch (codecFor(param).textKind) {
+        case PARAM_TEXT_NUMBER:
+            if (kind != JSON_VALUE_NUMBER) return "number expected";
+            break;
+        case PARAM_TEXT_BOOL:
+            if (kind != JSON_VALUE_BOOL) return "boolean expected";
+            break;
+        case PARAM_TEXT_STRING:
+            if (kind != JSON_VALUE_STRING) return "string expected";
+            break;
+    }
+    return tx.stageText(paramIndexOf(param), text);
+}
+
+// All-or-nothing: commit only if every key staged cleanly and the
+// document parsed; afterwards successCount is the number applied
+void HTTPSModule::finishTransaction(SetRequestResult& result, bool parsed) {
+    if (!parsed || result.errorCount > 0) {
+        result.successCount = 0;
+        return;
+    }
+
+    ParamIndex failed = PARAM_COUNT;
+    const char* error = result.tx.commit(&failed);
+    if (error) {
+        result.successCount = 0;
+        recordResult(result, failed < PARAM_COUNT ? system_params[failed].name : "", error);
+    }
+}
+
 // POST /api/set - set parameters
 esp_err_t HTTPSModule::set_post_handler(httpd_req_t *req) {
     HTTPSModule* instance = (HTTPSModule*)req->user_ctx;
+    track_request(req);
     if (!instance->is_authorized(req)) {
         instance->send_unauthorized(req);
         return ESP_OK;
     }
 
-    char buf[512];
-    int received = httpd_req_recv(req, buf, sizeof(buf) - 1);
-    if (received <= 0) return ESP_FAIL;
-    buf[received] = '\0';
+    if (header_has(req, "Content-Type", "application/cbor")) {
+        return set_post_cbor(req);
+    }
 
-    cJSON *root = cJSON_Parse(buf);
-    if (!root) {
-        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON");
+    if (req->content_len > API_MAX_BODY_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Body too large");
         return ESP_OK;
     }
 
-    int successCount = 0;
-    int errorCount = 0;
-    
-    // Process each parameter in JSON
-    cJSON *item = NULL;
-    cJSON_ArrayForEach(item, root) {
-        const char* paramName = item->string;
-        bool success = false;
-        
-        // Find parameter by name
-        for (int i = 0; i < PARAM_COUNT; i++) {
-            if (strcmp(paramName, system_params[i].name) == 0 && 
-                (system_params[i].flags & API_ACCESS)) {
-                
-                ConfigParam& param = system_params[i];
-                
-                // Set value based on type
-                switch (param.type) {
-                    case TYPE_FLOAT:
-                        if (cJSON_IsNumber(item)) {
-                            float newValue = item->valuedouble;
-                            if (newValue >= param.number.min_value && newValue <= param.number.max_value) {
-                                param.number.value = newValue;
-                                success = true;
-                            }
-                        }
-                        break;
-                    case TYPE_UINT8:
-                        if (cJSON_IsNumber(item)) {
-                            int newValue = item->valueint;
-                            if (newValue >= param.uint8.min_value && newValue <= param.uint8.max_value) {
-                                param.uint8.value = newValue;
-                                success = true;
-                            }
-                        }
-                        break;
-                    case TYPE_BOOL:
-                        if (cJSON_IsBool(item)) {
-                            param.boolean.value = cJSON_IsTrue(item);
-                            success = true;
-                        }
-                        break;
-                    case TYPE_STRING:
-                        if (cJSON_IsString(item)) {
-                            const char* newValue = item->valuestring;
-                            if (strlen(newValue) < param.string.max_size) {
-                                strncpy(param.string.value, newValue, param.string.max_size - 1);
-                                param.string.value[param.string.max_size - 1] = '\0';
-                                success = true;
-                            }
-                        }
-                        break;
-                }
-                break; // Parameter found, stop searching
+    SetRequestResult result;
+    JsonStreamParser parser(applyJsonPair, &result);
+
+    // Consume the body in chunks; each key is staged as soon as it is parsed
+    char buf[128];
+    size_t remaining = req->content_len;
+    uint8_t timeouts = 0;
+    bool parsed = true;
+    while (remaining > 0 && parsed) {
+        int received = httpd_req_recv(req, buf, min(remaining, sizeof(buf)));
+        if (received == HTTPD_SOCK_ERR_TIMEOUT) {
+            if (++timeouts > 3) {
+                httpd_resp_send_err(req, HTTPD_408_REQ_TIMEOUT, "Body timeout");
+                return ESP_OK;
             }
+            continue;
         }
-        
-        if (success) successCount++;
-        else errorCount++;
+        if (received <= 0) return ESP_FAIL;
+        remaining -= received;
+        parsed = parser.feed(buf, received);
+    }
+    if (parsed) {
+        parsed = parser.finish();
     }
+    finishTransaction(result, parsed);
 
-    cJSON_Delete(root);
-    
-    // Send response
+    // Send response (built in the request arena)
+    ArenaScope arena;
     cJSON *response_json = cJSON_CreateObject();
-    cJSON_AddNumberToObject(response_json, "success", successCount);
-    cJSON_AddNumberToObject(response_json, "errors", errorCount);
+    cJSON_AddNumberToObject(response_json, "success", result.successCount);
+    cJSON_AddNumberToObject(response_json, "errors", result.errorCount);
     cJSON_AddStringToObject(response_json, "message", 
-                           successCount > 0 ? "Parameters updated" : "No parameters updated");
+                           result.successCount > 0 ? "Parameters updated" : "No parameters updated");
+
+    if (result.errorCount > 0) {
+        cJSON *failed = cJSON_AddObjectToObject(response_json, "failed");
+        uint8_t listed = min(result.errorCount, (uint16_t)API_MAX_KEY_ERRORS);
+        for (uint8_t i = 0; i < listed; i++) {
+            cJSON_AddStringToObject(failed, result.keyErrors[i].key, result.keyErrors[i].reason);
+        }
+    }
+
+    if (!parsed) {
+        // Nothing was applied
+        httpd_resp_set_status(req, "400 Bad Request");
+        cJSON_AddStringToObject(response_json, "parse_error", parser.getError());
+        cJSON_AddNumberToObject(response_json, "parse_offset", parser.getErrorOffset());
+    }
     
     const char* response = cJSON_PrintUnformatted(response_json);
     httpd_resp_set_type(req, "application/json");
     httpd_resp_sendstr(req, response);
 
-    free((void*)response);
+    cJSON_free((void*)response);
     cJSON_Delete(response_json);
     return ESP_OK;
 }
 
+// POST /api/set with Content-Type: application/cbor. The body is a map
+// of param index -> value, read into one fixed buffer and decoded in place.
+esp_err_t HTTPSModule::set_post_cbor(httpd_req_t *req) {
+    if (req->content_len > API_MAX_CBOR_BODY_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Body too large");
+        return ESP_OK;
+    }
+
+    uint8_t body[API_MAX_CBOR_BODY_SIZE];
+    size_t received = 0;
+    uint8_t timeouts = 0;
+    while (received < req->content_len) {
+        int n = httpd_req_recv(req, (char*)body + received, req->content_len - received);
+        if (n == HTTPD_SOCK_ERR_TIMEOUT) {
+            if (++timeouts > 3) {
+                httpd_resp_send_err(req, HTTPD_408_REQ_TIMEOUT, "Body timeout");
+                return ESP_OK;
+            }
+            continue;
+        }
+        if (n <= 0) return ESP_FAIL;
+        received += n;
+    }
+
+    SetRequestResult result;
+
+    const char* parseError = nullptr;
+    CborReader reader(body, received);
+    CborItem map;
+    if (!reader.next(map) || map.kind != CBOR_ITEM_MAP) {
+        parseError = "map expected";
+    } else {
+        size_t pairs = 0;
+        while (map.indefinite || pairs < map.length) {
+            CborItem key, value;
+            if (!reader.next(key)) {
+                parseError = "truncated";
+                break;
+            }
+            if (key.kind == CBOR_ITEM_BREAK && map.indefinite) break;
+            if (!reader.skip(key) || !reader.next(value) || value.kind == CBOR_ITEM_BREAK) {
+                parseError = "truncated or unsupported value";
+                break;
+            }
+            // Map/array values are rejected per key below, but their
+            // contents must be consumed before the next key
+            if (!reader.skip(value)) {
+                parseError = "truncated or unsupported nested value";
+                break;
+            }
+            applyCborPair(result, key, value);
+            pairs++;
+        }
+    }
+    finishTransaction(result, parseError == nullptr);
+
+    httpd_resp_set_type(req, "application/cbor");
+    if (parseError) {
+        httpd_resp_set_status(req, "400 Bad Request");
+    }
+
+    CborStreamWriter out(JsonStreamWriter::httpdChunkFlush, req);
+    out.beginMap();
+    out.valueString("success");
+    out.valueUint(result.successCount);
+    out.valueString("errors");
+    out.valueUint(result.errorCount);
+    if (result.errorCount > 0) {
+        out.valueString("failed");
+        out.beginMap();
+        uint8_t listed = min(result.errorCount, (uint16_t)API_MAX_KEY_ERRORS);
+        for (uint8_t i = 0; i < listed; i++) {
+            out.valueString(result.keyErrors[i].key);
+            out.valueString(result.keyErrors[i].reason);
+        }
+        out.end();
+    }
+    if (parseError) {
+        out.valueString("parse_error");
+        out.valueString(parseError);
+        out.valueString("parse_offset");
+        out.valueUint(reader.getOffset());
+    }
+    out.end();
+    out.finish();
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
 void HTTPSModule::handleClient() {
     // HTTPS server runs in background
 }
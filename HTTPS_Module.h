@@ -3,14 +3,31 @@
 
 #include <esp_https_server.h>
 #include <cJSON.h>
+#include <atomic>
 #include "Param_helpers.h"
 #include "Param_types.h"
+#include "Json_Stream.h"
+#include "Json_Parser.h"
+#include "Cbor_Stream.h"
+#include "Param_transaction.h"
+#include "Event_Stream.h"
+
+#define API_MAX_KEY_ERRORS 8   // Per-key failures listed in /api/set responses
 
 class HTTPSModule {
   public:
     HTTPSModule();
     bool begin();
     void handleClient();
+
+    // Shared JSON value formatting (secured values are masked)
+    static void writeParamValue(JsonStreamWriter& json, const ConfigParam& param);
+    static void writeParamValue(CborStreamWriter& cbor, const ConfigParam& param);
+
+    // Traffic since boot, exposed as the computed api_requests and
+    // api_connections params so counting stays out of change tracking
+    static uint32_t getRequestCount() { return requestCount.load(std::memory_order_relaxed); }
+    static uint32_t getConnectionCount() { return connectionCount.load(std::memory_order_relaxed); }
     
   private:
     httpd_handle_t server = nullptr;
@@ -18,14 +35,52 @@ class HTTPSModule {
     // Only needed URIs
     httpd_uri_t set_uri;
     httpd_uri_t config_uri;
+    httpd_uri_t dimmer_stats_uri;
+    httpd_uri_t changes_uri;
+    httpd_uri_t stream_uri;
+
+    // Server-Sent Events subscribers of /api/stream
+    EventStream eventStream;
+
+    // Random per boot so ETags from before a reboot never match
+    uint32_t etagNonce = 0;
     
+    static std::atomic<uint32_t> requestCount;
+    static std::atomic<uint32_t> connectionCount;
+
     // Helper methods
+    static void track_request(httpd_req_t *req);
     bool is_authorized(httpd_req_t *req);
     void send_unauthorized(httpd_req_t *req);
+    void formatETag(char* buf, size_t size, uint32_t generation, const char* variant = "");
+    static bool select_params(httpd_req_t *req, ParamIndex* out, size_t& count);
+    static bool header_has(httpd_req_t *req, const char* header, const char* mediaType);
+
+    // /api/set state: keys are staged into one transaction while parsing
+    struct KeyError {
+        char key[JSON_PARSER_KEY_SIZE];
+        const char* reason;
+    };
+    struct SetRequestResult {
+        uint16_t successCount = 0;
+        uint16_t errorCount = 0;
+        KeyError keyErrors[API_MAX_KEY_ERRORS];
+        ParamTransaction tx;
+    };
+    static void applyJsonPair(void* ctx, const char* key, JsonValueKind kind, const char* text);
+    static void applyCborPair(SetRequestResult& result, const CborItem& key, const CborItem& value);
+    static void recordResult(SetRequestResult& result, const char* key, const char* error);
+    static const char* stageParamValue(ParamTransaction& tx, ConfigParam& param, JsonValueKind kind, const char* text);
+    static void finishTransaction(SetRequestResult& result, bool parsed);
     
     // Handler methods
     static esp_err_t set_post_handler(httpd_req_t *req);
+    static esp_err_t set_post_cbor(httpd_req_t *req);
     static esp_err_t config_get_handler(httpd_req_t *req);
+    static esp_err_t dimmer_stats_get_handler(httpd_req_t *req);
+    static esp_err_t changes_get_handler(httpd_req_t *req);
+    static esp_err_t stream_get_handler(httpd_req_t *req);
+    static void session_close(httpd_handle_t hd, int sockfd);
 };
 
 extern HTTPSModule httpsModule;
@@ -0,0 +1,282 @@
+#include "Json_Parser.h"
+
+JsonStreamParser::JsonStreamParser(JsonPairFn onPair, void* ctx) {
+  _onPair = onPair;
+  _ctx = ctx;
+  _state = EXPECT_OBJECT;
+  _error = nullptr;
+  _offset = 0;
+  _keyLen = 0;
+  _valueLen = 0;
+  _oversize = false;
+  _escape = false;
+  _unicodeDigits = 0;
+  _unicode = 0;
+  _number = NUM_SIGN;
+  _depth = 0;
+  _nestedInString = false;
+  _nestedEscape = false;
+}
+
+bool JsonStreamParser::feed(const char* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (_state == FAILED) return false;
+    if (!step(data[i])) return false;
+    _offset++;
+  }
+  return _state != FAILED;
+}
+
+bool JsonStreamParser::finish() {
+  if (_state == FAILED) return false;
+  if (_state != DONE) return fail("Unexpected end of input");
+  return true;
+}
+
+bool JsonStreamParser::fail(const char* error) {
+  _error = error;
+  _state = FAILED;
+  return false;
+}
+
+void JsonStreamParser::append(char* buf, size_t& len, size_t size, char c) {
+  if (len < size - 1) {
+    buf[len++] = c;
+  } else {
+    _oversize = true;
+  }
+}
+
+void JsonStreamParser::emit(JsonValueKind kind) {
+  _key[_keyLen] = '\0';
+  _value[_valueLen] = '\0';
+  _onPair(_ctx, _key, _oversize ? JSON_VALUE_OVERSIZE : kind, _value);
+  _keyLen = 0;
+  _valueLen = 0;
+  _oversize = false;
+}
+
+// Handles one character inside a string; returns true when the closing
+// quote has been consumed
+bool JsonStreamParser::stringChar(char c, char* buf, size_t& len, size_t size) {
+  if (_unicodeDigits > 0) {
+    uint8_t digit;
+    if (c >= '0' && c <= '9') digit = c - '0';
+    else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+    else { fail("Invalid \\u escape"); return false; }
+    _unicode = (_unicode << 4) | digit;
+    if (--_unicodeDigits == 0) {
+      // UTF-8 encode (BMP only; surrogate halves become '?')
+      if (_unicode < 0x80) {
+        append(buf, len, size, (char)_unicode);
+      } else if (_unicode < 0x800) {
+        append(buf, len, size, (char)(0xC0 | (_unicode >> 6)));
+        append(buf, len, size, (char)(0x80 | (_unicode & 0x3F)));
+      } else if (_unicode >= 0xD800 && _unicode <= 0xDFFF) {
+        append(buf, len, size, '?');
+      } else {
+        append(buf, len, size, (char)(0xE0 | (_unicode >> 12)));
+        append(buf, len, size, (char)(0x80 | ((_unicode >> 6) & 0x3F)));
+        append(buf, len, size, (char)(0x80 | (_unicode & 0x3F)));
+      }
+    }
+    return false;
+  }
+
+  if (_escape) {
+    _escape = false;
+    switch (c) {
+      case '"':  append(buf, len, size, '"'); break;
+      case '\\': append(buf, len, size, '\\'); break;
+      case '/':  append(buf, len, size, '/'); break;
+      case 'b':  append(buf, len, size, '\b'); break;
+      case 'f':  append(buf, len, size, '\f'); break;
+      case 'n':  append(buf, len, size, '\n'); break;
+      case 'r':  append(buf, len, size, '\r'); break;
+      case 't':  append(buf, len, size, '\t'); break;
+      case 'u':  _unicodeDigits = 4; _unicode = 0; break;
+      default:   fail("Invalid escape"); break;
+    }
+    return false;
+  }
+
+  if (c == '\\') {
+    _escape = true;
+    return false;
+  }
+  if (c == '"') {
+    return true;
+  }
+  if ((unsigned char)c < 0x20) {
+    fail("Control character in string");
+    return false;
+  }
+  append(buf, len, size, c);
+  return false;
+}
+
+// Advances the number grammar by one character:
+//   -? (0 | [1-9][0-9]*) (. [0-9]+)? ([eE] [+-]? [0-9]+)?
+bool JsonStreamParser::numberChar(char c) {
+  bool digit = c >= '0' && c <= '9';
+  switch (_number) {
+    case NUM_SIGN:
+      if (c == '0') { _number = NUM_ZERO; break; }
+      if (digit) { _number = NUM_INT; break; }
+      return fail("Invalid number");
+    case NUM_ZERO:
+    case NUM_INT:
+      if (digit && _number == NUM_INT) break;
+      if (c == '.') { _number = NUM_FRAC_START; break; }
+      if (c == 'e' || c == 'E') { _number = NUM_EXP_START; break; }
+      return fail("Invalid number");
+    case NUM_FRAC_START:
+    case NUM_FRAC:
+      if (digit) { _number = NUM_FRAC; break; }
+      if (_number == NUM_FRAC && (c == 'e' || c == 'E')) { _number = NUM_EXP_START; break; }
+      return fail("Invalid number");
+    case NUM_EXP_START:
+      if (c == '+' || c == '-') { _number = NUM_EXP_SIGN; break; }
+      // fall through
+    case NUM_EXP_SIGN:
+    case NUM_EXP:
+      if (digit) { _number = NUM_EXP; break; }
+      return fail("Invalid number");
+  }
+  append(_value, _valueLen, sizeof(_value), c);
+  return true;
+}
+
+bool JsonStreamParser::endNumber() {
+  if (_number != NUM_ZERO && _number != NUM_INT && _number != NUM_FRAC && _number != NUM_EXP) {
+    return fail("Invalid number");
+  }
+  emit(JSON_VALUE_NUMBER);
+  _state = EXPECT_COMMA_OR_END;
+  return true;
+}
+
+bool JsonStreamParser::endLiteral() {
+  _value[_valueLen] = '\0';
+  if (_oversize) {
+    return fail("Invalid literal");
+  } else if (strcmp(_value, "true") == 0 || strcmp(_value, "false") == 0) {
+    emit(JSON_VALUE_BOOL);
+  } else if (strcmp(_value, "null") == 0) {
+    emit(JSON_VALUE_NULL);
+  } else {
+    return fail("Invalid literal");
+  }
+  _state = EXPECT_COMMA_OR_END;
+  return true;
+}
+
+bool JsonStreamParser::step(char c) {
+  switch (_state) {
+    case EXPECT_OBJECT:
+      if (isSpace(c)) return true;
+      if (c != '{') return fail("Expected '{'");
+      _state = EXPECT_KEY_OR_END;
+      return true;
+
+    case EXPECT_KEY_OR_END:
+      if (isSpace(c)) return true;
+      if (c == '}') { _state = DONE; return true; }
+      if (c != '"') return fail("Expected key");
+      _state = IN_KEY;
+      return true;
+
+    case EXPECT_KEY:
+      if (isSpace(c)) return true;
+      if (c != '"') return fail("Expected key");
+      _state = IN_KEY;
+      return true;
+
+    case IN_KEY:
+      if (stringChar(c, _key, _keyLen, sizeof(_key))) _state = EXPECT_COLON;
+      return _state != FAILED;
+
+    case EXPECT_COLON:
+      if (isSpace(c)) return true;
+      if (c != ':') return fail("Expected ':'");
+      _state = EXPECT_VALUE;
+      return true;
+
+    case EXPECT_VALUE:
+      if (isSpace(c)) return true;
+      if (c == '"') {
+        _state = IN_STRING;
+      } else if (c == '{' || c == '[') {
+        _depth = 1;
+        _nestedInString = false;
+        _nestedEscape = false;
+        _state = IN_NESTED;
+      } else if (c == '-' || (c >= '0' && c <= '9')) {
+        _number = NUM_SIGN;
+        _state = IN_NUMBER;
+        if (c != '-') return numberChar(c);
+        append(_value, _valueLen, sizeof(_value), c);
+      } else if (c == 't' || c == 'f' || c == 'n') {
+        append(_value, _valueLen, sizeof(_value), c);
+        _state = IN_LITERAL;
+      } else {
+        return fail("Expected value");
+      }
+      return true;
+
+    case IN_STRING:
+      if (stringChar(c, _value, _valueLen, sizeof(_value))) {
+        emit(JSON_VALUE_STRING);
+        _state = EXPECT_COMMA_OR_END;
+      }
+      return _state != FAILED;
+
+    case IN_NUMBER:
+      if (c == ',' || c == '}' || isSpace(c)) {
+        if (!endNumber()) return false;
+        return step(c);   // Delimiter belongs to the next state
+      }
+      return numberChar(c);
+
+    case IN_LITERAL:
+      if (c == ',' || c == '}' || isSpace(c)) {
+        if (!endLiteral()) return false;
+        return step(c);
+      }
+      if (c < 'a' || c > 'z') return fail("Invalid literal");
+      append(_value, _valueLen, sizeof(_value), c);
+      return true;
+
+    case IN_NESTED:
+      if (_nestedInString) {
+        if (_nestedEscape) _nestedEscape = false;
+        else if (c == '\\') _nestedEscape = true;
+        else if (c == '"') _nestedInString = false;
+      } else if (c == '"') {
+        _nestedInString = true;
+      } else if (c == '{' || c == '[') {
+        if (++_depth == 0) return fail("Nesting too deep");
+      } else if (c == '}' || c == ']') {
+        if (--_depth == 0) {
+          emit(JSON_VALUE_NESTED);
+          _state = EXPECT_COMMA_OR_END;
+        }
+      }
+      return true;
+
+    case EXPECT_COMMA_OR_END:
+      if (isSpace(c)) return true;
+      if (c == ',') { _state = EXPECT_KEY; return true; }
+      if (c == '}') { _state = DONE; return true; }
+      return fail("Expected ',' or '}'");
+
+    case DONE:
+      if (isSpace(c)) return true;
+      return fail("Trailing data after object");
+
+    case FAILED:
+      return false;
+  }
+  return false;
+}
@@ -0,0 +1,101 @@
+#ifndef JSON_PARSER_H
+#define JSON_PARSER_H
+
+#include <Arduino.h>
+
+#define JSON_PARSER_KEY_SIZE    32
+#define JSON_PARSER_VALUE_SIZE  72
+
+enum JsonValueKind {
+    JSON_VALUE_STRING,
+    JSON_VALUE_NUMBER,
+    JSON_VALUE_BOOL,
+    JSON_VALUE_NULL,
+    JSON_VALUE_NESTED,     // Object/array value: skipped, not supported
+    JSON_VALUE_OVERSIZE    // Key or value did not fit the fixed buffers
+};
+
+// Called for each top-level key/value as soon as it is complete. Strings
+// are unescaped; numbers (RFC 8259 grammar only - no nan/inf/hex) and the
+// true/false/null literals are passed as their source text.
+typedef void (*JsonPairFn)(void* ctx, const char* key, JsonValueKind kind, const char* text);
+
+// Incremental, allocation-free tokenizer for a flat JSON object. Input can
+// be fed in arbitrary chunks (e.g. straight from httpd_req_recv).
+class JsonStreamParser {
+  public:
+    JsonStreamParser(JsonPairFn onPair, void* ctx);
+
+    // Consume one chunk; returns false once a syntax error has been hit
+    bool feed(const char* data, size_t len);
+
+    // Call after the last chunk; false if the document is incomplete
+    bool finish();
+
+    const char* getError() const { return _error; }
+    size_t getErrorOffset() const { return _offset; }
+
+  private:
+    enum State {
+        EXPECT_OBJECT,
+        EXPECT_KEY_OR_END,
+        EXPECT_KEY,
+        IN_KEY,
+        EXPECT_COLON,
+        EXPECT_VALUE,
+        IN_STRING,
+        IN_NUMBER,
+        IN_LITERAL,
+        IN_NESTED,
+        EXPECT_COMMA_OR_END,
+        DONE,
+        FAILED
+    };
+
+    JsonPairFn _onPair;
+    void* _ctx;
+    State _state;
+    const char* _error;
+    size_t _offset;
+
+    char _key[JSON_PARSER_KEY_SIZE];
+    size_t _keyLen;
+    char _value[JSON_PARSER_VALUE_SIZE];
+    size_t _valueLen;
+    bool _oversize;
+
+    // String escapes (shared by keys and values)
+    bool _escape;
+    uint8_t _unicodeDigits;
+    uint16_t _unicode;
+
+    // RFC 8259 number grammar position
+    enum NumberState : uint8_t {
+        NUM_SIGN,          // After '-'
+        NUM_ZERO,          // Leading 0 (no further integer digits)
+        NUM_INT,
+        NUM_FRAC_START,    // After '.'
+        NUM_FRAC,
+        NUM_EXP_START,     // After 'e'/'E'
+        NUM_EXP_SIGN,      // After the exponent sign
+        NUM_EXP
+    };
+    NumberState _number;
+
+    // Skipping nested values
+    uint8_t _depth;
+    bool _nestedInString;
+    bool _nestedEscape;
+
+    bool step(char c);
+    bool stringChar(char c, char* buf, size_t& len, size_t size);
+    void append(char* buf, size_t& len, size_t size, char c);
+    bool numberChar(char c);
+    bool endNumber();
+    bool endLiteral();
+    void emit(JsonValueKind kind);
+    bool fail(const char* error);
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+};
+
+#endif
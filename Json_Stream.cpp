@@ -0,0 +1,166 @@
+#include "Json_Stream.h"
+#include <esp_https_server.h>
+
+JsonStreamWriter::JsonStreamWriter(JsonFlushFn flush, void* ctx) {
+  _flush = flush;
+  _ctx = ctx;
+  _len = 0;
+  _needComma = false;
+  _ok = true;
+}
+
+bool JsonStreamWriter::httpdChunkFlush(void* ctx, const char* data, size_t len) {
+  return httpd_resp_send_chunk((httpd_req_t*)ctx, data, len) == ESP_OK;
+}
+
+void JsonStreamWriter::beginObject() {
+  separator();
+  writeChar('{');
+  _needComma = false;
+}
+
+void JsonStreamWriter::endObject() {
+  writeChar('}');
+  _needComma = true;
+}
+
+void JsonStreamWriter::beginArray() {
+  separator();
+  writeChar('[');
+  _needComma = false;
+}
+
+void JsonStreamWriter::endArray() {
+  writeChar(']');
+  _needComma = true;
+}
+
+void JsonStreamWriter::key(const char* name) {
+  separator();
+  writeChar('"');
+  writeEscaped(name);
+  write("\":", 2);
+  _needComma = false;
+}
+
+void JsonStreamWriter::valueFloat(float value) {
+  separator();
+  if (isnan(value) || isinf(value)) {
+    write("null", 4);   // JSON has no NaN/Inf
+  } else {
+    char num[20];
+    int n = snprintf(num, sizeof(num), "%.7g", value);
+    write(num, n);
+  }
+  _needComma = true;
+}
+
+void JsonStreamWriter::valueInt(long value) {
+  separator();
+  char num[16];
+  int n = snprintf(num, sizeof(num), "%ld", value);
+  write(num, n);
+  _needComma = true;
+}
+
+void JsonStreamWriter::valueUint(unsigned long value) {
+  separator();
+  char num[16];
+  int n = snprintf(num, sizeof(num), "%lu", value);
+  write(num, n);
+  _needComma = true;
+}
+
+void JsonStreamWriter::valueBool(bool value) {
+  separator();
+  write(value ? "true" : "false");
+  _needComma = true;
+}
+
+void JsonStreamWriter::valueString(const char* value) {
+  separator();
+  writeChar('"');
+  writeEscaped(value);
+  writeChar('"');
+  _needComma = true;
+}
+
+void JsonStreamWriter::valueNull() {
+  separator();
+  write("null", 4);
+  _needComma = true;
+}
+
+void JsonStreamWriter::valueNumber(const char* text) {
+  separator();
+  const char* digits = (*text == '-') ? text + 1 : text;
+  if (isdigit((unsigned char)*digits)) {
+    write(text);
+  } else {
+    write("null", 4);   // nan/inf have no JSON form
+  }
+  _needComma = true;
+}
+
+bool JsonStreamWriter::finish() {
+  flushBuffer();
+  return _ok;
+}
+
+void JsonStreamWriter::separator() {
+  if (_needComma) {
+    writeChar(',');
+    _needComma = false;
+  }
+}
+
+void JsonStreamWriter::write(const char* data, size_t len) {
+  while (len > 0) {
+    size_t room = sizeof(_buf) - _len;
+    size_t n = (len < room) ? len : room;
+    memcpy(_buf + _len, data, n);
+    _len += n;
+    data += n;
+    len -= n;
+    if (_len == sizeof(_buf)) {
+      flushBuffer();
+    }
+  }
+}
+
+void JsonStreamWriter::writeChar(char c) {
+  _buf[_len++] = c;
+  if (_len == sizeof(_buf)) {
+    flushBuffer();
+  }
+}
+
+void JsonStreamWriter::writeEscaped(const char* str) {
+  for (; *str; str++) {
+    unsigned char c = *str;
+    switch (c) {
+      case '"':  write("\\\"", 2); break;
+      case '\\': write("\\\\", 2); break;
+      case '\n': write("\\n", 2); break;
+      case '\r': write("\\r", 2); break;
+      case '\t': write("\\t", 2); break;
+      default:
+        if (c < 0x20) {
+          char esc[7];
+          snprintf(esc, sizeof(esc), "\\u%04x", c);
+          write(esc, 6);
+        } else {
+          writeChar(c);
+        }
+        break;
+    }
+  }
+}
+
+void JsonStreamWriter::flushBuffer() {
+  if (_len == 0) return;
+  if (_ok && !_flush(_ctx, _buf, _len)) {
+    _ok = false;   // Client gone: keep formatting cheap, stop sending
+  }
+  _len = 0;
+}
@@ -0,0 +1,55 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <Arduino.h>
+
+#define JSON_STREAM_BUFFER_SIZE 256
+
+// Sink for formatted JSON; returns false to abort the stream
+typedef bool (*JsonFlushFn)(void* ctx, const char* data, size_t len);
+
+// Tree-less JSON writer. Values are formatted straight into a small fixed
+// buffer which is handed to the sink whenever it fills up, so memory use
+// does not depend on document size.
+class JsonStreamWriter {
+  public:
+    JsonStreamWriter(JsonFlushFn flush, void* ctx);
+
+    // Sink for chunked httpd responses (ctx = httpd_req_t*)
+    static bool httpdChunkFlush(void* ctx, const char* data, size_t len);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const char* name);
+
+    void valueFloat(float value);
+    void valueInt(long value);
+    void valueUint(unsigned long value);
+    void valueBool(bool value);
+    void valueString(const char* value);
+    void valueNull();
+    void valueNumber(const char* text);   // Preformatted number; non-numbers become null
+
+    // Flush whatever is buffered; returns false if any flush failed
+    bool finish();
+    bool ok() const { return _ok; }
+
+  private:
+    JsonFlushFn _flush;
+    void* _ctx;
+    char _buf[JSON_STREAM_BUFFER_SIZE];
+    size_t _len;
+    bool _needComma;
+    bool _ok;
+
+    void separator();
+    void write(const char* data, size_t len);
+    void write(const char* str) { write(str, strlen(str)); }
+    void writeChar(char c);
+    void writeEscaped(const char* str);
+    void flushBuffer();
+};
+
+#endif
@@ -1,11 +1,13 @@
 #include "PID_AutoTune_v2.h"
 #include "BurstFireDimmer.h"
+#include "Temp_Estimator.h"
 
 PID_AutoTune_v2::PID_AutoTune_v2(double* input, double* output, double* setpoint, BurstFireDimmer* dimmer) {
   _myInput = input;
   _myOutput = output;
   _mySetpoint = setpoint;
   _dimmer = dimmer;
+  _estimator = nullptr;
 
   // Initialize with parameters from new system
   SetTunings(
@@ -57,6 +59,10 @@ void PID_AutoTune_v2::Compute() {
       _ITerm += (_Ki * error);
       _ITerm = constrain(_ITerm, 0, getPidMaxPower());  // Only positive
       double dInput = (currentTemp - _lastInput);
+      if (_estimator && _estimator->isValid() && getParamBool(PARAM_KALMAN_ENABLED)) {
+        // Kalman rate instead of differencing quantized samples
+        dInput = _estimator->getRate() * ((double)_sampleTime / 1000);
+      }
       *_myOutput = (_Kp * error) + _ITerm - (_Kd * dInput);
       *_myOutput = ApplyPowerLimits(*_myOutput, tempDifference);
     }
@@ -66,6 +72,10 @@ void PID_AutoTune_v2::Compute() {
   _lastInput = currentTemp;
 }
 
+void PID_AutoTune_v2::SetEstimator(const TempEstimator* estimator) {
+  _estimator = estimator;
+}
+
 double PID_AutoTune_v2::ApplyPowerLimits(double output, double tempDifference) {
   double maxPower = getPidMaxPower();
   double minPower = getPidMinPower();
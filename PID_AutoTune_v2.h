@@ -5,8 +5,9 @@
 #include "Param_helpers.h"
 #include "Param_types.h"
 
-// Forward declaration
+// Forward declarations
 class BurstFireDimmer;
+class TempEstimator;
 
 class PID_AutoTune_v2 {
   public:
@@ -16,6 +17,9 @@ class PID_AutoTune_v2 {
     // Main PID computation method
     void Compute();
     
+    // Use the estimator's dT/dt for the derivative term (nullptr = raw input)
+    void SetEstimator(const TempEstimator* estimator);
+
     // Manual tuning parameters setup
     void SetTunings(double Kp, double Ki, double Kd);
     
@@ -39,6 +43,7 @@ class PID_AutoTune_v2 {
     double* _myOutput;
     double* _mySetpoint;
     BurstFireDimmer* _dimmer;
+    const TempEstimator* _estimator;
 
     // PID coefficients
     double _Kp, _Ki, _Kd;
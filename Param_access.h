@@ -0,0 +1,217 @@
+#ifndef PARAM_ACCESS_H
+#define PARAM_ACCESS_H
+
+#include "Param_types.h"
+#include "Param_helpers.h"
+#include <type_traits>
+
+// Compile-time typed access: param<PARAM_TEMP_SETPOINT>() returns a float,
+// param<PARAM_POWER_LEVEL>() a uint8_t, and each call inlines to a direct
+// load of the right union member. The runtime getParamFloat()/... helpers
+// stay for code that only has the index at runtime.
+// COMPUTED parameters have no stored value; param<>()/setParam<>() refuse
+// them at compile time, read those through getParamValue()/formatParam()
+// or the runtime getters.
+
+enum ParamStorageKind {
+    PARAM_STORED   = 0,
+    PARAM_COMPUTED = COMPUTED
+};
+
+// Type and storage of every parameter, in enum order. This is the only
+// place a parameter's type is written down: the type column of
+// param_config.cpp is PARAM_TYPE(index). The COMPUTED flag in the table
+// must match the storage column; verifyParamAccessTypes() checks that at
+// startup and the static_assert below checks the count.
+#define PARAM_ACCESS_TYPES(X) \
+    X(PARAM_VERSION,                 TYPE_UINT8,  PARAM_STORED) \
+    X(PARAM_UPTIME,                  TYPE_STRING, PARAM_COMPUTED) \
+    X(PARAM_POWER_LEVEL,             TYPE_UINT8,  PARAM_STORED) \
+    X(PARAM_TEMP_SETPOINT,           TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_SETPOINT_MIN,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_SETPOINT_MAX,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_HYSTERESIS,         TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_CURRENT_TEMP,            TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_CALIBRATION,        TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_SENSOR_TYPE,        TYPE_UINT8,  PARAM_STORED) \
+    X(PARAM_UPDATE_INTERVAL,         TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_HEATER_ENABLED,          TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_PID_KP,                  TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_KI,                  TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_KD,                  TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_SAMPLE_TIME,         TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_MAX_POWER,           TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_MIN_POWER,           TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_MAX_TEMP_DIFF,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_MIN_TEMP_DIFF,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_SWITCHING_DELTA,     TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_HEATER_RUNNING,          TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_OPERATING_MODE,          TYPE_UINT8,  PARAM_STORED) \
+    X(PARAM_WIFI_SSID,               TYPE_STRING, PARAM_STORED) \
+    X(PARAM_WIFI_PASSWORD,           TYPE_STRING, PARAM_STORED) \
+    X(PARAM_MQTT_SERVER,             TYPE_STRING, PARAM_STORED) \
+    X(PARAM_MQTT_PORT,               TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_API_TOKEN,               TYPE_STRING, PARAM_STORED) \
+    X(PARAM_HTTPS_ENABLED,           TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_HTTPS_PORT,              TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_NTP_SERVER,              TYPE_STRING, PARAM_STORED) \
+    X(PARAM_NTP_GMT_OFFSET,          TYPE_INT16,  PARAM_STORED) \
+    X(PARAM_NTP_DAYLIGHT_OFFSET,     TYPE_INT16,  PARAM_STORED) \
+    X(PARAM_HEATER_WATTAGE,          TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_ENERGY_TOTAL,            TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_ENERGY_BATCH,            TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_BATCH_HEATER_HOURS,      TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_DUTY_1M,                 TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_DUTY_1H,                 TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_DUTY_24H,                TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_MULTI_PROBE,        TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_TEMP_PROBE_COUNT,        TYPE_UINT8,  PARAM_STORED) \
+    X(PARAM_TEMP_BUS_TIME,           TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PROBE_WORT_ROM,          TYPE_STRING, PARAM_STORED) \
+    X(PARAM_PROBE_JACKET_ROM,        TYPE_STRING, PARAM_STORED) \
+    X(PARAM_PROBE_AMBIENT_ROM,       TYPE_STRING, PARAM_STORED) \
+    X(PARAM_PROBE_WORT_TEMP,         TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PROBE_JACKET_TEMP,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PROBE_AMBIENT_TEMP,      TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PROBE_WORT_AGE,          TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_PROBE_JACKET_AGE,        TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_PROBE_AMBIENT_AGE,       TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_PROBE_WORT_ERRORS,       TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_PROBE_JACKET_ERRORS,     TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_PROBE_AMBIENT_ERRORS,    TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_TEMP_FILTER_CALIBRATION, TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_TEMP_FILTER_MEDIAN,      TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_TEMP_FILTER_SLEW,        TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_TEMP_FILTER_EMA,         TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_TEMP_EMA_ALPHA,          TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_MAX_SLEW,           TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_TEMP_REJECTED,           TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_TEMP_FILTER_TIME,        TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_KALMAN_ENABLED,          TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_HEATER_GAIN,             TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_KALMAN_MEAS_NOISE,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_KALMAN_PROC_NOISE,       TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_PID_PREDICT_HORIZON,     TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_EST_TEMP,                TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_EST_RATE,                TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_EST_LOSS,                TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_SAMPLE_ADAPTIVE,         TYPE_BOOL,   PARAM_STORED) \
+    X(PARAM_SAMPLE_MIN_INTERVAL,     TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_SAMPLE_MAX_INTERVAL,     TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_SAMPLE_RATE_THRESHOLD,   TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_SAMPLES_PER_HOUR,        TYPE_FLOAT,  PARAM_STORED) \
+    X(PARAM_ARENA_PEAK,              TYPE_UINT16, PARAM_COMPUTED) \
+    X(PARAM_ARENA_OVERFLOWS,         TYPE_UINT16, PARAM_COMPUTED) \
+    X(PARAM_HEAP_LARGEST_BLOCK,      TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_STREAM_INTERVAL,         TYPE_UINT16, PARAM_STORED) \
+    X(PARAM_API_REQUESTS,            TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_API_CONNECTIONS,         TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_WIFI_RSSI,               TYPE_INT16,  PARAM_COMPUTED) \
+    X(PARAM_HEAP_FREE,               TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_TIME_TO_SETPOINT,        TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_DISPLAY_MAX_FPS,         TYPE_UINT8,  PARAM_STORED) \
+    X(PARAM_DISPLAY_I2C_BPS,         TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_LOOP_TIME_US,            TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_DISPLAY_RENDER_US,       TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_DISPLAY_FLUSH_US,        TYPE_FLOAT,  PARAM_COMPUTED) \
+    X(PARAM_TIME_SYNCED,             TYPE_BOOL,   PARAM_COMPUTED)
+
+// C++ type and union member behind each ParamType
+template<ParamType T> struct ParamStorage;
+
+template<> struct ParamStorage<TYPE_FLOAT> {
+    typedef float type;
+    static float& ref(ConfigParam& p) { return p.number.value; }
+};
+
+template<> struct ParamStorage<TYPE_UINT8> {
+    typedef uint8_t type;
+    static uint8_t& ref(ConfigParam& p) { return p.uint8.value; }
+};
+
+template<> struct ParamStorage<TYPE_UINT16> {
+    typedef uint16_t type;
+    static uint16_t& ref(ConfigParam& p) { return p.uint16.value; }
+};
+
+template<> struct ParamStorage<TYPE_INT16> {
+    typedef int16_t type;
+    static int16_t& ref(ConfigParam& p) { return p.int16.value; }
+};
+
+template<> struct ParamStorage<TYPE_BOOL> {
+    typedef bool type;
+    static bool& ref(ConfigParam& p) { return p.boolean.value; }
+};
+
+// No specialization for an index means it is missing from PARAM_ACCESS_TYPES
+template<ParamIndex I> struct ParamTraits;
+
+#define PARAM_ACCESS_TRAITS(index, ptype, storage) \
+    template<> struct ParamTraits<index> { \
+        static constexpr ParamType type = ptype; \
+        static constexpr bool computed = (storage) == PARAM_COMPUTED; \
+    };
+PARAM_ACCESS_TYPES(PARAM_ACCESS_TRAITS)
+#undef PARAM_ACCESS_TRAITS
+
+// Type column of the param_config.cpp table
+#define PARAM_TYPE(index) (ParamTraits<index>::type)
+
+#define PARAM_ACCESS_COUNT(index, ptype, storage) + 1
+static_assert(0 PARAM_ACCESS_TYPES(PARAM_ACCESS_COUNT) == PARAM_COUNT,
+              "PARAM_ACCESS_TYPES must list every parameter");
+#undef PARAM_ACCESS_COUNT
+
+// Strings are read as a pointer and written through the checked setter
+template<ParamIndex I, ParamType T = ParamTraits<I>::type>
+struct ParamAccess {
+    typedef typename ParamStorage<T>::type type;
+
+    static type get() { return ParamStorage<T>::ref(system_params[I]); }
+
+    static void set(type value) {
+        type& slot = ParamStorage<T>::ref(system_params[I]);
+        if (slot == value) return;
+        slot = value;
+        markParamChanged(I);
+    }
+};
+
+template<ParamIndex I>
+struct ParamAccess<I, TYPE_STRING> {
+    typedef const char* type;
+
+    static type get() { return getParamString(I); }
+    static void set(type value) { setParamString(I, value); }
+};
+
+template<ParamIndex I>
+inline typename ParamAccess<I>::type param() {
+    static_assert(!ParamTraits<I>::computed,
+                  "param: COMPUTED parameter has no stored value, use getParamValue()");
+    return ParamAccess<I>::get();
+}
+
+// The argument must be of the same kind as the parameter: a float
+// expression cannot silently truncate into an integer parameter and
+// a number cannot land in a bool (or the other way round)
+template<ParamIndex I, typename V>
+inline void setParam(V value) {
+    typedef typename ParamAccess<I>::type T;
+    static_assert(!ParamTraits<I>::computed,
+                  "setParam: COMPUTED parameters are read-only");
+    static_assert(std::is_floating_point<T>::value == std::is_floating_point<V>::value,
+                  "setParam: float/integer mismatch with the parameter type");
+    static_assert(std::is_same<T, bool>::value == std::is_same<V, bool>::value,
+                  "setParam: bool/number mismatch with the parameter type");
+    static_assert(std::is_convertible<V, T>::value,
+                  "setParam: value not convertible to the parameter type");
+    ParamAccess<I>::set(static_cast<T>(value));
+}
+
+// Compare PARAM_ACCESS_TYPES (order, COMPUTED flag) with system_params;
+// logs and returns false on the first mismatch
+bool verifyParamAccessTypes();
+
+#endif
@@ -0,0 +1,81 @@
+#include "Param_bus.h"
+#include "Param_helpers.h"
+
+ParamBus paramBus;
+
+ParamBus::ParamBus()
+    : _head(0), _tail(0), _overflowed(false), _overflows(0), _dispatchedGen(0),
+      _mux(portMUX_INITIALIZER_UNLOCKED), _subCount(0) {}
+
+bool ParamBus::subscribe(ParamIndex index, ParamListener listener, void* ctx) {
+    return addSubscriber(index, 0, listener, ctx);
+}
+
+bool ParamBus::subscribeFlags(uint16_t flagMask, ParamListener listener, void* ctx) {
+    return addSubscriber(-1, flagMask, listener, ctx);
+}
+
+bool ParamBus::addSubscriber(int16_t index, uint16_t flagMask, ParamListener listener, void* ctx) {
+    if (_subCount >= PARAM_BUS_MAX_SUBSCRIBERS) {
+        Serial.println("ParamBus: no free subscriber slot");
+        return false;
+    }
+    _subs[_subCount++] = { listener, ctx, index, flagMask };
+    return true;
+}
+
+void ParamBus::publish(ParamIndex index, uint32_t generation) {
+    portENTER_CRITICAL(&_mux);
+    uint8_t next = (_head + 1) % PARAM_BUS_QUEUE_SIZE;
+    if (next == _tail) {
+        _overflowed = true;     // Dropped; dispatch() rescans instead
+        _overflows++;
+    } else {
+        _ring[_head] = { (uint16_t)index, generation };
+        _head = next;
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void ParamBus::dispatch() {
+    Event batch[PARAM_BUS_QUEUE_SIZE];
+    uint8_t count = 0;
+    bool overflowed;
+
+    portENTER_CRITICAL(&_mux);
+    while (_tail != _head) {
+        batch[count++] = _ring[_tail];
+        _tail = (_tail + 1) % PARAM_BUS_QUEUE_SIZE;
+    }
+    overflowed = _overflowed;
+    _overflowed = false;
+    portEXIT_CRITICAL(&_mux);
+
+    if (overflowed) {
+        // The queued events are a subset of this scan
+        uint32_t since = _dispatchedGen;
+        for (int i = 0; i < PARAM_COUNT; i++) {
+            uint32_t gen = getParamChangedGen(static_cast<ParamIndex>(i));
+            if (gen > since) deliver(static_cast<ParamIndex>(i), gen);
+        }
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        ParamIndex index = static_cast<ParamIndex>(batch[i].index);
+        // A later change of the same parameter is queued (or on its way)
+        if (getParamChangedGen(index) != batch[i].generation) continue;
+        deliver(index, batch[i].generation);
+    }
+}
+
+void ParamBus::deliver(ParamIndex index, uint32_t generation) {
+    uint16_t flags = system_params[index].flags;
+    for (uint8_t i = 0; i < _subCount; i++) {
+        const Subscriber& sub = _subs[i];
+        if (sub.index == index || (sub.flagMask & flags)) {
+            sub.listener(index, generation, sub.ctx);
+        }
+    }
+    if (generation > _dispatchedGen) _dispatchedGen = generation;
+}
@@ -0,0 +1,62 @@
+#ifndef PARAM_BUS_H
+#define PARAM_BUS_H
+
+#include "Config.h"
+#include "Param_types.h"
+
+// Called from ParamBus::dispatch() on the loop task
+typedef void (*ParamListener)(ParamIndex index, uint32_t generation, void* ctx);
+
+// Change notification for parameters. markParamChanged() publishes
+// (index, generation) into a fixed ring from any task; dispatch() drains it
+// in loop() and calls every subscriber registered for that parameter or for
+// one of its flags. A change superseded by a later one is delivered once.
+// If the ring overflows, the next dispatch rescans the change generations,
+// so listeners miss nothing.
+class ParamBus {
+  public:
+    ParamBus();
+
+    // Register during setup(); false when all subscriber slots are taken
+    bool subscribe(ParamIndex index, ParamListener listener, void* ctx = nullptr);
+    bool subscribeFlags(uint16_t flagMask, ParamListener listener, void* ctx = nullptr);
+
+    // Queue a change (any task)
+    void publish(ParamIndex index, uint32_t generation);
+
+    // Deliver queued changes (loop task)
+    void dispatch();
+
+    uint16_t getOverflows() const { return _overflows; }
+
+  private:
+    struct Event {
+        uint16_t index;
+        uint32_t generation;
+    };
+
+    struct Subscriber {
+        ParamListener listener;
+        void* ctx;
+        int16_t index;        // -1 = match by flags
+        uint16_t flagMask;
+    };
+
+    Event _ring[PARAM_BUS_QUEUE_SIZE];
+    uint8_t _head;
+    uint8_t _tail;
+    bool _overflowed;
+    uint16_t _overflows;
+    uint32_t _dispatchedGen;      // Newest generation already delivered
+    portMUX_TYPE _mux;
+
+    Subscriber _subs[PARAM_BUS_MAX_SUBSCRIBERS];
+    uint8_t _subCount;
+
+    bool addSubscriber(int16_t index, uint16_t flagMask, ParamListener listener, void* ctx);
+    void deliver(ParamIndex index, uint32_t generation);
+};
+
+extern ParamBus paramBus;
+
+#endif
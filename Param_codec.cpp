@@ -0,0 +1,351 @@
+#include "Param_codec.h"
+#include "Param_helpers.h"
+
+// Integer text -> long, rejecting empty input and trailing garbage
+static const char* parseLong(const char* text, long minValue, long maxValue, long& out) {
+    char* end;
+    out = strtol(text, &end, 10);
+    if (end == text) return "number expected";
+    while (*end == ' ') end++;
+    if (*end != '\0') return "invalid number";
+    if (out < minValue || out > maxValue) return "out of range";
+    return nullptr;
+}
+
+static long clampLong(long value, long minValue, long maxValue) {
+    return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+}
+
+static void putLE(uint8_t* out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out[i] = value >> (8 * i);
+    }
+}
+
+static uint32_t getLE(const uint8_t* in, size_t bytes) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value |= (uint32_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// ---- float ----
+
+static void floatLoad(const ConfigParam& p, ParamValue& v) { v.number = p.number.value; }
+static void floatDefault(const ConfigParam& p, ParamValue& v) { v.number = p.number.default_value; }
+static void floatStore(ConfigParam& p, const ParamValue& v) { p.number.value = v.number; }
+static bool floatEquals(const ConfigParam& p, const ParamValue& v) { return p.number.value == v.number; }
+
+static const char* floatValidate(const ConfigParam& p, const ParamValue& v) {
+    // Written so that NaN fails as well
+    if (!(v.number >= p.number.min_value && v.number <= p.number.max_value)) return "out of range";
+    return nullptr;
+}
+
+static const char* floatParse(const ConfigParam& p, const char* text, ParamValue& v) {
+    char* end;
+    v.number = strtof(text, &end);
+    if (end == text) return "number expected";
+    while (*end == ' ') end++;
+    if (*end != '\0') return "invalid number";
+    return floatValidate(p, v);
+}
+
+// Decimals needed to show one step (0.1 -> 1, 0.01 -> 2, 1 -> 0)
+static int stepDecimals(float step) {
+    int decimals = 0;
+    while (decimals < 4 && fabsf(step - roundf(step)) > step * 0.01f) {
+        step *= 10;
+        decimals++;
+    }
+    return decimals;
+}
+
+static size_t floatFormat(const ConfigParam& p, const ParamValue& v, ParamFormatStyle style, char* buf, size_t size) {
+    int n;
+    if (style == PARAM_FORMAT_DISPLAY) {
+        n = snprintf(buf, size, "%.*f", stepDecimals(p.number.step), v.number);
+    } else {
+        n = snprintf(buf, size, "%.7g", v.number);
+    }
+    return n < (int)size ? n : size - 1;
+}
+
+static size_t floatDescribe(const ConfigParam& p, char* buf, size_t size) {
+    return snprintf(buf, size, "between %g and %g", p.number.min_value, p.number.max_value);
+}
+
+static void floatStep(const ConfigParam& p, int steps, ParamValue& v) {
+    v.number = constrain(v.number + steps * p.number.step, p.number.min_value, p.number.max_value);
+}
+
+static size_t floatSerialize(const ConfigParam& p, const ParamValue& v, uint8_t* out, size_t size) {
+    if (size < 4) return 0;
+    uint32_t bits;
+    memcpy(&bits, &v.number, sizeof(bits));
+    putLE(out, bits, 4);
+    return 4;
+}
+
+static bool floatDeserialize(const ConfigParam& p, const uint8_t* in, size_t len, ParamValue& v) {
+    if (len != 4) return false;
+    uint32_t bits = getLE(in, 4);
+    memcpy(&v.number, &bits, sizeof(bits));
+    return true;
+}
+
+// ---- integers (one implementation, limits and width per type) ----
+
+static void intLimits(const ConfigParam& p, long& minValue, long& maxValue, long& step) {
+    switch (p.type) {
+        case TYPE_UINT8:  minValue = p.uint8.min_value;  maxValue = p.uint8.max_value;  step = p.uint8.step;  break;
+        case TYPE_UINT16: minValue = p.uint16.min_value; maxValue = p.uint16.max_value; step = p.uint16.step; break;
+        default:          minValue = p.int16.min_value;  maxValue = p.int16.max_value;  step = p.int16.step;  break;
+    }
+}
+
+static long intGet(const ConfigParam& p, const ParamValue& v) {
+    switch (p.type) {
+        case TYPE_UINT8:  return v.uint8;
+        case TYPE_UINT16: return v.uint16;
+        default:          return v.int16;
+    }
+}
+
+static void intSet(const ConfigParam& p, ParamValue& v, long value) {
+    switch (p.type) {
+        case TYPE_UINT8:  v.uint8 = value;  break;
+        case TYPE_UINT16: v.uint16 = value; break;
+        default:          v.int16 = value;  break;
+    }
+}
+
+static size_t intWidth(const ConfigParam& p) {
+    return p.type == TYPE_UINT8 ? 1 : 2;
+}
+
+static void intLoad(const ConfigParam& p, ParamValue& v) {
+    switch (p.type) {
+        case TYPE_UINT8:  v.uint8 = p.uint8.value;   break;
+        case TYPE_UINT16: v.uint16 = p.uint16.value; break;
+        default:          v.int16 = p.int16.value;   break;
+    }
+}
+
+static void intDefault(const ConfigParam& p, ParamValue& v) {
+    switch (p.type) {
+        case TYPE_UINT8:  v.uint8 = p.uint8.default_value;   break;
+        case TYPE_UINT16: v.uint16 = p.uint16.default_value; break;
+        default:          v.int16 = p.int16.default_value;   break;
+    }
+}
+
+static void intStore(ConfigParam& p, const ParamValue& v) {
+    switch (p.type) {
+        case TYPE_UINT8:  p.uint8.value = v.uint8;   break;
+        case TYPE_UINT16: p.uint16.value = v.uint16; break;
+        default:          p.int16.value = v.int16;   break;
+    }
+}
+
+static bool intEquals(const ConfigParam& p, const ParamValue& v) {
+    ParamValue current;
+    intLoad(p, current);
+    return intGet(p, current) == intGet(p, v);
+}
+
+static const char* intValidate(const ConfigParam& p, const ParamValue& v) {
+    long minValue, maxValue, step;
+    intLimits(p, minValue, maxValue, step);
+    long value = intGet(p, v);
+    return (value < minValue || value > maxValue) ? "out of range" : nullptr;
+}
+
+static const char* intParse(const ConfigParam& p, const char* text, ParamValue& v) {
+    long minValue, maxValue, step, value;
+    intLimits(p, minValue, maxValue, step);
+    const char* error = parseLong(text, minValue, maxValue, value);
+    if (!error) intSet(p, v, value);
+    return error;
+}
+
+static size_t intFormat(const ConfigParam& p, const ParamValue& v, ParamFormatStyle style, char* buf, size_t size) {
+    int n = snprintf(buf, size, "%ld", intGet(p, v));
+    return n < (int)size ? n : size - 1;
+}
+
+static size_t intDescribe(const ConfigParam& p, char* buf, size_t size) {
+    long minValue, maxValue, step;
+    intLimits(p, minValue, maxValue, step);
+    return snprintf(buf, size, "between %ld and %ld", minValue, maxValue);
+}
+
+static void intStep(const ConfigParam& p, int steps, ParamValue& v) {
+    long minValue, maxValue, step;
+    intLimits(p, minValue, maxValue, step);
+    intSet(p, v, clampLong(intGet(p, v) + steps * step, minValue, maxValue));
+}
+
+static size_t intSerialize(const ConfigParam& p, const ParamValue& v, uint8_t* out, size_t size) {
+    size_t width = intWidth(p);
+    if (size < width) return 0;
+    putLE(out, (uint32_t)intGet(p, v), width);
+    return width;
+}
+
+static bool intDeserialize(const ConfigParam& p, const uint8_t* in, size_t len, ParamValue& v) {
+    if (len != intWidth(p)) return false;
+    uint32_t raw = getLE(in, len);
+    intSet(p, v, p.type == TYPE_INT16 ? (long)(int16_t)raw : (long)raw);
+    return true;
+}
+
+// ---- bool ----
+
+static void boolLoad(const ConfigParam& p, ParamValue& v) { v.boolean = p.boolean.value; }
+static void boolDefault(const ConfigParam& p, ParamValue& v) { v.boolean = p.boolean.default_value; }
+static void boolStore(ConfigParam& p, const ParamValue& v) { p.boolean.value = v.boolean; }
+static bool boolEquals(const ConfigParam& p, const ParamValue& v) { return p.boolean.value == v.boolean; }
+static const char* boolValidate(const ConfigParam& p, const ParamValue& v) { return nullptr; }
+
+static const char* boolParse(const ConfigParam& p, const char* text, ParamValue& v) {
+    if (!strcmp(text, "1") || !strcmp(text, "true") || !strcmp(text, "on")) {
+        v.boolean = true;
+    } else if (!strcmp(text, "0") || !strcmp(text, "false") || !strcmp(text, "off")) {
+        v.boolean = false;
+    } else {
+        return "boolean expected";
+    }
+    return nullptr;
+}
+
+static size_t boolFormat(const ConfigParam& p, const ParamValue& v, ParamFormatStyle style, char* buf, size_t size) {
+    const char* text = (style == PARAM_FORMAT_DISPLAY) ? (v.boolean ? "ON" : "OFF")
+                                                        : (v.boolean ? "true" : "false");
+    strncpy(buf, text, size - 1);
+    buf[size - 1] = '\0';
+    return strlen(buf);
+}
+
+static size_t boolDescribe(const ConfigParam& p, char* buf, size_t size) {
+    return snprintf(buf, size, "0/1, true/false, or on/off");
+}
+
+static void boolStep(const ConfigParam& p, int steps, ParamValue& v) {
+    if (steps & 1) v.boolean = !v.boolean;
+}
+
+static size_t boolSerialize(const ConfigParam& p, const ParamValue& v, uint8_t* out, size_t size) {
+    if (size < 1) return 0;
+    out[0] = v.boolean ? 1 : 0;
+    return 1;
+}
+
+static bool boolDeserialize(const ConfigParam& p, const uint8_t* in, size_t len, ParamValue& v) {
+    if (len != 1 || in[0] > 1) return false;
+    v.boolean = in[0];
+    return true;
+}
+
+// ---- string ----
+
+static void copyString(char* dst, size_t dstSize, const char* src, size_t maxSize) {
+    size_t limit = (maxSize < dstSize ? maxSize : dstSize) - 1;
+    size_t len = strnlen(src, limit);
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+static void stringLoad(const ConfigParam& p, ParamValue& v) {
+    size_t len = p.string.length < sizeof(v.string) ? p.string.length : sizeof(v.string) - 1;
+    memcpy(v.string, paramStringData(p), len);
+    v.string[len] = '\0';
+}
+
+static void stringDefault(const ConfigParam& p, ParamValue& v) {
+    copyString(v.string, sizeof(v.string), p.string.default_value, p.string.max_size);
+}
+
+static void stringStore(ConfigParam& p, const ParamValue& v) {
+    storeParamString(p, v.string, strnlen(v.string, sizeof(v.string)));
+}
+
+static bool stringEquals(const ConfigParam& p, const ParamValue& v) {
+    size_t len = strnlen(v.string, sizeof(v.string));
+    return len == p.string.length && memcmp(paramStringData(p), v.string, len) == 0;
+}
+
+static const char* stringValidate(const ConfigParam& p, const ParamValue& v) {
+    return strnlen(v.string, sizeof(v.string)) >= p.string.max_size ? "too long" : nullptr;
+}
+
+static const char* stringParse(const ConfigParam& p, const char* text, ParamValue& v) {
+    if (strlen(text) >= p.string.max_size || strlen(text) >= sizeof(v.string)) return "too long";
+    strcpy(v.string, text);
+    return nullptr;
+}
+
+static size_t stringFormat(const ConfigParam& p, const ParamValue& v, ParamFormatStyle style, char* buf, size_t size) {
+    copyString(buf, size, v.string, sizeof(v.string));
+    return strlen(buf);
+}
+
+static size_t stringDescribe(const ConfigParam& p, char* buf, size_t size) {
+    return snprintf(buf, size, "a string up to %d characters", (int)p.string.max_size - 1);
+}
+
+static void stringStep(const ConfigParam& p, int steps, ParamValue& v) {
+}
+
+// Length-prefixed so short strings stay short in EEPROM
+static size_t stringSerialize(const ConfigParam& p, const ParamValue& v, uint8_t* out, size_t size) {
+    size_t len = strnlen(v.string, p.string.max_size - 1);
+    if (size < len + 1) return 0;
+    out[0] = len;
+    memcpy(out + 1, v.string, len);
+    return len + 1;
+}
+
+static bool stringDeserialize(const ConfigParam& p, const uint8_t* in, size_t len, ParamValue& v) {
+    if (len < 1 || in[0] != len - 1 || in[0] >= p.string.max_size) return false;
+    memcpy(v.string, in + 1, in[0]);
+    v.string[in[0]] = '\0';
+    return true;
+}
+
+// Indexed by ParamType
+const ParamCodec param_codecs[] = {
+    [TYPE_FLOAT]  = { "float",  PARAM_TEXT_NUMBER, floatLoad, floatDefault, floatStore, floatEquals, floatParse, floatValidate,
+                      floatFormat, floatDescribe, floatStep, floatSerialize, floatDeserialize },
+    [TYPE_UINT8]  = { "uint8",  PARAM_TEXT_NUMBER, intLoad, intDefault, intStore, intEquals, intParse, intValidate,
+                      intFormat, intDescribe, intStep, intSerialize, intDeserialize },
+    [TYPE_UINT16] = { "uint16", PARAM_TEXT_NUMBER, intLoad, intDefault, intStore, intEquals, intParse, intValidate,
+                      intFormat, intDescribe, intStep, intSerialize, intDeserialize },
+    [TYPE_INT16]  = { "int16",  PARAM_TEXT_NUMBER, intLoad, intDefault, intStore, intEquals, intParse, intValidate,
+                      intFormat, intDescribe, intStep, intSerialize, intDeserialize },
+    [TYPE_BOOL]   = { "bool",   PARAM_TEXT_BOOL, boolLoad, boolDefault, boolStore, boolEquals, boolParse, boolValidate,
+                      boolFormat, boolDescribe, boolStep, boolSerialize, boolDeserialize },
+    [TYPE_STRING] = { "string", PARAM_TEXT_STRING, stringLoad, stringDefault, stringStore, stringEquals, stringParse, stringValidate,
+                      stringFormat, stringDescribe, stringStep, stringSerialize, stringDeserialize },
+};
+
+const char* parseParamText(ParamIndex index, const char* text, ParamValue& out) {
+    const ConfigParam& param = system_params[index];
+    const ParamCodec& codec = codecFor(param);
+    const char* error = codec.parse(param, text, out);
+    return error ? error : codec.validate(param, out);
+}
+
+size_t formatParam(ParamIndex index, ParamFormatStyle style, char* buf, size_t size) {
+    const ConfigParam& param = system_params[index];
+    if (param.flags & SECURED_VALUE) {
+        strncpy(buf, "******", size - 1);
+        buf[size - 1] = '\0';
+        return strlen(buf);
+    }
+
+    ParamValue value;
+    getParamValue(index, value);   // Runs the getter of a COMPUTED parameter
+    return codecFor(param).format(param, value, style, buf, size);
+}
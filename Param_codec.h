@@ -0,0 +1,60 @@
+#ifndef PARAM_CODEC_H
+#define PARAM_CODEC_H
+
+#include "Param_types.h"
+
+#define PARAM_TEXT_SIZE 72   // Caller buffer for any formatted value
+
+enum ParamFormatStyle {
+    PARAM_FORMAT_RAW,       // Machine form: "%.7g", true/false (serial, REST)
+    PARAM_FORMAT_DISPLAY    // Human form: decimals from the step, ON/OFF (OLED)
+};
+
+// How a type's text form maps onto JSON
+enum ParamTextKind {
+    PARAM_TEXT_NUMBER,
+    PARAM_TEXT_BOOL,
+    PARAM_TEXT_STRING
+};
+
+// One implementation of every per-type operation, dispatched through
+// param_codecs[type]. Nothing here allocates; text goes to caller buffers.
+struct ParamCodec {
+    const char* typeName;
+    ParamTextKind textKind;
+
+    // Table value <-> detached value
+    void (*load)(const ConfigParam& param, ParamValue& out);
+    void (*loadDefault)(const ConfigParam& param, ParamValue& out);
+    void (*store)(ConfigParam& param, const ParamValue& value);
+    bool (*equals)(const ConfigParam& param, const ParamValue& value);
+
+    // Text -> value (syntax and range); nullptr or an error reason
+    const char* (*parse)(const ConfigParam& param, const char* text, ParamValue& out);
+    // Range/size check of a detached value; nullptr or an error reason
+    const char* (*validate)(const ConfigParam& param, const ParamValue& value);
+    // Value -> text; returns the length written (always NUL terminated)
+    size_t (*format)(const ConfigParam& param, const ParamValue& value, ParamFormatStyle style, char* buf, size_t size);
+    // Accepted input in words, for error messages
+    size_t (*describe)(const ConfigParam& param, char* buf, size_t size);
+    // Move by a number of steps, clamped to the limits (rotary editing)
+    void (*step)(const ConfigParam& param, int steps, ParamValue& value);
+
+    // Compact little-endian storage form (EEPROM); serialize returns bytes written
+    size_t (*serialize)(const ConfigParam& param, const ParamValue& value, uint8_t* out, size_t size);
+    bool (*deserialize)(const ConfigParam& param, const uint8_t* in, size_t len, ParamValue& out);
+};
+
+extern const ParamCodec param_codecs[];
+
+inline const ParamCodec& codecFor(const ConfigParam& param) {
+    return param_codecs[param.type];
+}
+
+// Parse and validate text for a parameter without touching the table
+const char* parseParamText(ParamIndex index, const char* text, ParamValue& out);
+
+// Format the current value (secured values come out masked)
+size_t formatParam(ParamIndex index, ParamFormatStyle style, char* buf, size_t size);
+
+#endif
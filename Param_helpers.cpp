@@ -1,93 +1,356 @@
 #include "Param_helpers.h"
+#include "Param_codec.h"
+#include "Param_access.h"
+#include "Param_bus.h"
+#include "Config.h"
+
+// Change tracking state (generation 0 means "never changed since boot")
+static volatile uint32_t param_generation = 0;
+static uint32_t param_changed_gen[PARAM_COUNT];
+static portMUX_TYPE param_gen_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Characters of all string parameters, one max_size slot each
+static char param_string_arena[PARAM_STRING_ARENA_SIZE];
+static bool param_strings_laid_out = false;
+
+// Getters of COMPUTED parameters
+static ParamGetter param_getters[PARAM_COUNT];
+
+// Per-flag index lists; position table maps a parameter to its slot
+// in each list (PARAM_LIST_NONE if absent)
+#define PARAM_LIST_NONE 0xFF
+static_assert(PARAM_COUNT < PARAM_LIST_NONE, "parameter indices must fit the uint8_t lists");
+
+static const uint16_t param_list_masks[PARAM_LIST_COUNT] = {
+    [PARAM_LIST_SERIAL]   = SERIAL_MENU,
+    [PARAM_LIST_DISPLAY]  = DISPLAY_ACCESS,
+    [PARAM_LIST_ROTARY]   = DISPLAY_ACCESS | ROTARY_ACCESS,
+    [PARAM_LIST_API]      = API_ACCESS,
+    [PARAM_LIST_MQTT]     = MQTT_ACCESS,
+    [PARAM_LIST_INFLUXDB] = INFLUXDB_REPORT,
+    [PARAM_LIST_STREAM]   = STREAM_ACCESS,
+};
+static uint8_t param_list_items[PARAM_LIST_COUNT][PARAM_COUNT];
+static uint8_t param_list_pos[PARAM_LIST_COUNT][PARAM_COUNT];
+static uint8_t param_list_count[PARAM_LIST_COUNT];
+static bool param_lists_built = false;
+
+// Parameter indices ordered by name
+static uint16_t param_name_index[PARAM_COUNT];
+static bool param_name_index_built = false;
 
 // Getters
 float getParamFloat(ParamIndex index) {
+    if (param_getters[index]) {
+        ParamValue value;
+        param_getters[index](value);
+        return value.number;
+    }
     return system_params[index].number.value;
 }
 
 uint8_t getParamUint8(ParamIndex index) {
+    if (param_getters[index]) {
+        ParamValue value;
+        param_getters[index](value);
+        return value.uint8;
+    }
     return system_params[index].uint8.value;
 }
 
 uint16_t getParamUint16(ParamIndex index) {
+    if (param_getters[index]) {
+        ParamValue value;
+        param_getters[index](value);
+        return value.uint16;
+    }
     return system_params[index].uint16.value;
 }
 
 int16_t getParamInt16(ParamIndex index) {
+    if (param_getters[index]) {
+        ParamValue value;
+        param_getters[index](value);
+        return value.int16;
+    }
     return system_params[index].int16.value;
 }
 
 bool getParamBool(ParamIndex index) {
+    if (param_getters[index]) {
+        ParamValue value;
+        param_getters[index](value);
+        return value.boolean;
+    }
     return system_params[index].boolean.value;
 }
 
 const char* getParamString(ParamIndex index) {
-    return system_params[index].string.value;
+    return getParamStringView(index).data;
 }
 
-// Setters  
+// A computed string has no arena slot of its own to point into (tasks
+// reading it at once would overwrite each other's value): it reads as
+// empty, its readers go through getParamValue() or formatParam()
+ParamStringView getParamStringView(ParamIndex index) {
+    const ConfigParam& param = system_params[index];
+    if (param.flags & COMPUTED) return { "", 0 };
+    return { paramStringData(param), param.string.length };
+}
+
+// Setters (only a real change bumps the generation)
 void setParamFloat(ParamIndex index, float value) {
+    if (system_params[index].number.value == value) return;
     system_params[index].number.value = value;
+    markParamChanged(index);
 }
 
 void setParamUint8(ParamIndex index, uint8_t value) {
+    if (system_params[index].uint8.value == value) return;
     system_params[index].uint8.value = value;
+    markParamChanged(index);
 }
 
 void setParamUint16(ParamIndex index, uint16_t value) {
+    if (system_params[index].uint16.value == value) return;
     system_params[index].uint16.value = value;
+    markParamChanged(index);
 }
 
 void setParamInt16(ParamIndex index, int16_t value) {
+    if (system_params[index].int16.value == value) return;
     system_params[index].int16.value = value;
+    markParamChanged(index);
 }
 
 void setParamBool(ParamIndex index, bool value) {
+    if (system_params[index].boolean.value == value) return;
     system_params[index].boolean.value = value;
+    markParamChanged(index);
 }
 
 void setParamString(ParamIndex index, const char* value) {
-    strncpy(system_params[index].string.value, value, system_params[index].string.max_size - 1);
-    system_params[index].string.value[system_params[index].string.max_size - 1] = '\0';
+    setParamString(index, value, strnlen(value, system_params[index].string.max_size));
 }
 
-// Display helper
-String getParamDisplayValue(ParamIndex index) {
-    ConfigParam& param = system_params[index];
-    
-    // Mask secured values
-    if (param.flags & SECURED_VALUE) {
-        return "******";
+void setParamString(ParamIndex index, const char* value, size_t length) {
+    if (storeParamString(system_params[index], value, length)) {
+        markParamChanged(index);
     }
+}
+
+// String arena
+static char* stringSlot(const ConfigParam& param) {
+    if (!param_strings_laid_out) layoutParamStrings();
+    return param_string_arena + param.string.offset;
+}
+
+void layoutParamStrings() {
+    param_strings_laid_out = true;
+    size_t offset = 0;
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        ConfigParam& param = system_params[i];
+        if (param.type != TYPE_STRING) continue;
+        
+        // Out of arena: the parameter keeps an empty string in the last byte
+        if (offset + param.string.max_size > PARAM_STRING_ARENA_SIZE) {
+            Serial.printf("String arena full at %s (PARAM_STRING_ARENA_SIZE %d)\n",
+                          param.name, PARAM_STRING_ARENA_SIZE);
+            param.string.offset = PARAM_STRING_ARENA_SIZE - 1;
+            param.string.max_size = 1;
+        } else {
+            param.string.offset = offset;
+            offset += param.string.max_size;
+        }
+        
+        param.string.length = 0;
+        param_string_arena[param.string.offset] = '\0';
+        storeParamString(param, param.string.default_value,
+                         strnlen(param.string.default_value, param.string.max_size));
+    }
+}
+
+const char* paramStringData(const ConfigParam& param) {
+    return stringSlot(param);
+}
+
+// Copies only the characters and one terminator (no strncpy padding)
+bool storeParamString(ConfigParam& param, const char* value, size_t length) {
+    if (length > param.string.max_size - 1u) length = param.string.max_size - 1u;
+    char* slot = stringSlot(param);
+    if (length == param.string.length && memcmp(slot, value, length) == 0) return false;
+    memcpy(slot, value, length);
+    slot[length] = '\0';
+    param.string.length = length;
+    return true;
+}
+
+void setParamGetter(ParamIndex index, ParamGetter getter) {
+    if (!(system_params[index].flags & COMPUTED)) {
+        Serial.printf("setParamGetter: %s is not COMPUTED\n", system_params[index].name);
+        return;
+    }
+    param_getters[index] = getter;
+}
+
+// Change tracking
+uint32_t getParamGeneration() {
+    return param_generation;
+}
+
+uint32_t getParamChangedGen(ParamIndex index) {
+    return param_changed_gen[index];
+}
+
+void markParamChanged(ParamIndex index) {
+    portENTER_CRITICAL(&param_gen_mux);
+    uint32_t generation = ++param_generation;
+    param_changed_gen[index] = generation;
+    portEXIT_CRITICAL(&param_gen_mux);
+    paramBus.publish(index, generation);
+}
+
+ParamIndex paramIndexOf(const ConfigParam& param) {
+    return static_cast<ParamIndex>(&param - system_params);
+}
+
+// Typed accessor table check
+bool verifyParamAccessTypes() {
+    static const struct { ParamIndex index; uint16_t storage; } declared[] = {
+#define PARAM_ACCESS_ENTRY(index, ptype, storage) { index, storage },
+        PARAM_ACCESS_TYPES(PARAM_ACCESS_ENTRY)
+#undef PARAM_ACCESS_ENTRY
+    };
     
-    // Return actual value for non-secured parameters
-    switch (param.type) {
-        case TYPE_FLOAT:
-            return String(param.number.value);  // ← ПРЯМОЙ ДОСТУП к значению
-        case TYPE_UINT8:
-            return String(param.uint8.value);   // ← ПРЯМОЙ ДОСТУП к значению
-        case TYPE_UINT16:
-            return String(param.uint16.value);  // ← ПРЯМОЙ ДОСТУП к значению
-        case TYPE_INT16:
-            return String(param.int16.value);  // ← ПРЯМОЙ ДОСТУП к значению
-        case TYPE_BOOL:
-            return param.boolean.value ? "true" : "false";  // ← ПРЯМОЙ ДОСТУП
-        case TYPE_STRING:
-            return String(param.string.value);  // ← ПРЯМОЙ ДОСТУП к значению
-        default:
-            return "unknown";
+    for (size_t i = 0; i < sizeof(declared) / sizeof(declared[0]); i++) {
+        const ConfigParam& param = system_params[declared[i].index];
+        if (declared[i].index != i) {
+            Serial.printf("PARAM_ACCESS_TYPES out of enum order at %u (%s)\n", (unsigned)i, param.name);
+            return false;
+        }
+        if ((param.flags & COMPUTED) != declared[i].storage) {
+            Serial.printf("PARAM_ACCESS_TYPES storage mismatch at %u (%s): COMPUTED flag %s in param_config.cpp\n",
+                          (unsigned)i, param.name, (param.flags & COMPUTED) ? "set" : "missing");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Per-flag lists
+void buildParamLists() {
+    for (int list = 0; list < PARAM_LIST_COUNT; list++) {
+        uint16_t mask = param_list_masks[list];
+        uint8_t count = 0;
+        for (int i = 0; i < PARAM_COUNT; i++) {
+            if ((system_params[i].flags & mask) == mask) {
+                param_list_pos[list][i] = count;
+                param_list_items[list][count++] = i;
+            } else {
+                param_list_pos[list][i] = PARAM_LIST_NONE;
+            }
+        }
+        param_list_count[list] = count;
+    }
+    param_lists_built = true;
+}
+
+ParamList getParamList(ParamListId list) {
+    if (!param_lists_built) buildParamLists();
+    return { param_list_items[list], param_list_count[list] };
+}
+
+int paramListStep(ParamListId list, int index, int direction) {
+    if (!param_lists_built) buildParamLists();
+    int count = param_list_count[list];
+    if (count == 0) return index;
+    if (index < 0 || index >= PARAM_COUNT || param_list_pos[list][index] == PARAM_LIST_NONE) {
+        return param_list_items[list][0];
+    }
+    int pos = (param_list_pos[list][index] + direction % count + count) % count;
+    return param_list_items[list][pos];
+}
+
+// Name index
+void buildParamNameIndex() {
+    // Insertion sort: runs once on a small table
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        uint16_t current = i;
+        int j = i - 1;
+        while (j >= 0 && strcmp(system_params[param_name_index[j]].name, system_params[current].name) > 0) {
+            param_name_index[j + 1] = param_name_index[j];
+            j--;
+        }
+        param_name_index[j + 1] = current;
+    }
+    param_name_index_built = true;
+}
+
+// First position in the sorted index whose name is not less than key
+// (compares at most len characters when len is non-zero)
+static int lowerBound(const char* key, size_t len) {
+    if (!param_name_index_built) buildParamNameIndex();
+
+    int lo = 0;
+    int hi = PARAM_COUNT;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        const char* name = system_params[param_name_index[mid]].name;
+        int cmp = len ? strncmp(name, key, len) : strcmp(name, key);
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
     }
+    return lo;
+}
+
+int findParamByName(const char* name) {
+    int pos = lowerBound(name, 0);
+    if (pos < PARAM_COUNT && strcmp(system_params[param_name_index[pos]].name, name) == 0) {
+        return param_name_index[pos];
+    }
+    return -1;
+}
+
+size_t findParamsByPrefix(const char* prefix, ParamIndex* out, size_t maxOut) {
+    size_t len = strlen(prefix);
+    if (len == 0) return 0;
+
+    size_t count = 0;
+    for (int pos = lowerBound(prefix, len); pos < PARAM_COUNT && count < maxOut; pos++) {
+        uint16_t index = param_name_index[pos];
+        if (strncmp(system_params[index].name, prefix, len) != 0) break;
+        out[count++] = static_cast<ParamIndex>(index);
+    }
+    return count;
+}
+
+// Generic access through the type codec
+void getParamValue(ParamIndex index, ParamValue& out) {
+    if (param_getters[index]) {
+        param_getters[index](out);
+        return;
+    }
+    codecFor(system_params[index]).load(system_params[index], out);
+}
+
+void setParamValue(ParamIndex index, const ParamValue& value) {
+    const ParamCodec& codec = codecFor(system_params[index]);
+    if (codec.equals(system_params[index], value)) return;
+    codec.store(system_params[index], value);
+    markParamChanged(index);
+}
+
+// Display helper
+String getParamDisplayValue(ParamIndex index) {
+    char text[PARAM_TEXT_SIZE];
+    formatParam(index, PARAM_FORMAT_RAW, text, sizeof(text));   // Masks secured values
+    return String(text);
 }
 
 // Type conversion
 const char* typeToString(ParamType type) {
-    switch (type) {
-        case TYPE_FLOAT: return "float";
-        case TYPE_UINT8: return "uint8";
-        case TYPE_UINT16: return "uint16";
-        case TYPE_INT16: return "uint16";
-        case TYPE_BOOL: return "bool";
-        case TYPE_STRING: return "string";
-        default: return "unknown";
-    }
+    return (type <= TYPE_STRING) ? param_codecs[type].typeName : "unknown";
 }
\ No newline at end of file
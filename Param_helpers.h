@@ -16,6 +16,73 @@ bool getParamBool(ParamIndex index);
 void setParamBool(ParamIndex index, bool value);
 const char* getParamString(ParamIndex index);
 void setParamString(ParamIndex index, const char* value);
+void setParamString(ParamIndex index, const char* value, size_t length);
+
+// String values share one arena, a slot of max_size bytes per TYPE_STRING
+// parameter, laid out (and set to the defaults) by layoutParamStrings()
+// at the start of setup(). Views point into the arena: no copy, valid
+// until the parameter is next written. COMPUTED strings are not held in
+// the arena and read as empty here; use getParamValue()/formatParam().
+struct ParamStringView {
+    const char* data;   // NUL terminated
+    uint8_t length;
+};
+
+void layoutParamStrings();
+ParamStringView getParamStringView(ParamIndex index);
+// Raw slot access for the codec (no change tracking); store returns
+// true if the value changed
+const char* paramStringData(const ConfigParam& param);
+bool storeParamString(ConfigParam& param, const char* value, size_t length);
+
+// Type-independent access (dispatches through the codec table)
+void getParamValue(ParamIndex index, ParamValue& out);
+void setParamValue(ParamIndex index, const ParamValue& value);
+
+// Computed parameters (COMPUTED flag): the getter runs on every read and
+// nothing is stored or change-tracked. Registered once in setup().
+typedef void (*ParamGetter)(ParamValue& out);
+void setParamGetter(ParamIndex index, ParamGetter getter);
+
+// Change tracking: a global generation counter, bumped on every value
+// change, and the generation at which each parameter last changed
+uint32_t getParamGeneration();
+uint32_t getParamChangedGen(ParamIndex index);
+void markParamChanged(ParamIndex index);
+ParamIndex paramIndexOf(const ConfigParam& param);
+
+// Name lookup through an index sorted by name (binary search).
+// buildParamNameIndex() runs once in setup(), before any front end.
+void buildParamNameIndex();
+int findParamByName(const char* name);   // -1 if unknown
+size_t findParamsByPrefix(const char* prefix, ParamIndex* out, size_t maxOut);
+
+// Dense per-flag index lists in table order, built once in setup() by
+// buildParamLists(). Enumeration touches only the list, and stepping
+// through a list (rotary navigation) is O(1) via a position table.
+enum ParamListId {
+    PARAM_LIST_SERIAL,      // SERIAL_MENU
+    PARAM_LIST_DISPLAY,     // DISPLAY_ACCESS
+    PARAM_LIST_ROTARY,      // DISPLAY_ACCESS and ROTARY_ACCESS
+    PARAM_LIST_API,         // API_ACCESS
+    PARAM_LIST_MQTT,        // MQTT_ACCESS
+    PARAM_LIST_INFLUXDB,    // INFLUXDB_REPORT
+    PARAM_LIST_STREAM,      // STREAM_ACCESS
+    PARAM_LIST_COUNT
+};
+
+struct ParamList {
+    const uint8_t* items;
+    uint8_t count;
+
+    ParamIndex operator[](uint8_t i) const { return static_cast<ParamIndex>(items[i]); }
+};
+
+void buildParamLists();
+ParamList getParamList(ParamListId list);
+// Neighbour of index in the list, wrapping around; the first entry when
+// index is not in the list, index itself when the list is empty
+int paramListStep(ParamListId list, int index, int direction);
 
 // Display helper
 String getParamDisplayValue(ParamIndex index);
@@ -0,0 +1,128 @@
+#include "Param_transaction.h"
+#include "Param_helpers.h"
+#include "Param_codec.h"
+#include "EEPROM_Manager.h"
+
+extern EEPROMManager eepromManager;
+
+// Serializes commits against each other. The typed setters and the
+// codec writes outside a transaction do not take it, so it excludes other
+// writers only where a critical section stops the scheduler (single-core
+// parts); on dual-core parts a reader on the other core can still see a
+// commit half applied.
+static portMUX_TYPE param_tx_mux = portMUX_INITIALIZER_UNLOCKED;
+
+ParamTransaction::ParamTransaction() : _count(0) {
+}
+
+void ParamTransaction::clear() {
+    _count = 0;
+}
+
+// Existing entry for index (a key staged twice keeps the last value),
+// a new one, or nullptr when the transaction is full
+ParamTransaction::Entry* ParamTransaction::slotFor(ParamIndex index) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_entries[i].index == index) return &_entries[i];
+    }
+    if (_count >= PARAM_TX_MAX_ENTRIES) return nullptr;
+
+    Entry* entry = &_entries[_count++];
+    entry->index = index;
+    return entry;
+}
+
+const char* ParamTransaction::stage(ParamIndex index, const ParamValue& value) {
+    if (system_params[index].flags & COMPUTED) return "read-only";
+
+    const char* error = codecFor(system_params[index]).validate(system_params[index], value);
+    if (error) return error;
+
+    Entry* entry = slotFor(index);
+    if (!entry) return "too many parameters";
+    entry->value = value;
+    return nullptr;
+}
+
+const char* ParamTransaction::stageText(ParamIndex index, const char* text) {
+    if (system_params[index].flags & COMPUTED) return "read-only";
+
+    ParamValue value;
+    const char* error = parseParamText(index, text, value);
+    return error ? error : stage(index, value);
+}
+
+bool ParamTransaction::isStaged(ParamIndex index) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_entries[i].index == index) return true;
+    }
+    return false;
+}
+
+// Value the param will have after commit (float params only)
+float ParamTransaction::effectiveFloat(ParamIndex index) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_entries[i].index == index) return _entries[i].value.number;
+    }
+    return system_params[index].number.value;
+}
+
+const char* ParamTransaction::checkOrdered(ParamIndex low, ParamIndex high, ParamIndex* failed) const {
+    if (!isStaged(low) && !isStaged(high)) return nullptr;
+    if (effectiveFloat(low) <= effectiveFloat(high)) return nullptr;
+
+    if (failed) *failed = isStaged(low) ? low : high;
+    return "min above max";
+}
+
+const char* ParamTransaction::validate(ParamIndex* failed) const {
+    const char* error;
+
+    if ((error = checkOrdered(PARAM_TEMP_SETPOINT_MIN, PARAM_TEMP_SETPOINT_MAX, failed))) return error;
+    if ((error = checkOrdered(PARAM_PID_MIN_POWER, PARAM_PID_MAX_POWER, failed))) return error;
+    if ((error = checkOrdered(PARAM_PID_MIN_TEMP_DIFF, PARAM_PID_MAX_TEMP_DIFF, failed))) return error;
+    if ((error = checkOrdered(PARAM_SAMPLE_MIN_INTERVAL, PARAM_SAMPLE_MAX_INTERVAL, failed))) return error;
+
+    // Setpoint must lie inside its (possibly also changing) limits
+    if (isStaged(PARAM_TEMP_SETPOINT) || isStaged(PARAM_TEMP_SETPOINT_MIN) || isStaged(PARAM_TEMP_SETPOINT_MAX)) {
+        float setpoint = effectiveFloat(PARAM_TEMP_SETPOINT);
+        if (setpoint < effectiveFloat(PARAM_TEMP_SETPOINT_MIN) ||
+            setpoint > effectiveFloat(PARAM_TEMP_SETPOINT_MAX)) {
+            if (failed) *failed = PARAM_TEMP_SETPOINT;
+            return "setpoint outside min/max";
+        }
+    }
+
+    return nullptr;
+}
+
+const char* ParamTransaction::commit(ParamIndex* failed) {
+    const char* error = validate(failed);
+    if (error) return error;
+
+    bool persist = false;
+    bool changed[PARAM_TX_MAX_ENTRIES];
+
+    // Publish every staged value in one critical section; values equal to
+    // the current one are left alone so they do not count as changes
+    portENTER_CRITICAL(&param_tx_mux);
+    for (uint8_t i = 0; i < _count; i++) {
+        ConfigParam& param = system_params[_entries[i].index];
+        const ParamCodec& codec = codecFor(param);
+        changed[i] = !codec.equals(param, _entries[i].value);
+        if (!changed[i]) continue;
+        codec.store(param, _entries[i].value);
+        if (!(param.flags & NO_FLASH_SAVE)) persist = true;
+    }
+    portEXIT_CRITICAL(&param_tx_mux);
+
+    for (uint8_t i = 0; i < _count; i++) {
+        if (changed[i]) markParamChanged(_entries[i].index);
+    }
+
+    // One EEPROM write for the whole transaction
+    if (persist) {
+        eepromManager.saveConfig();
+    }
+    return nullptr;
+}
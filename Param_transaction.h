@@ -0,0 +1,52 @@
+#ifndef PARAM_TRANSACTION_H
+#define PARAM_TRANSACTION_H
+
+#include "Param_types.h"
+
+#define PARAM_TX_MAX_ENTRIES 12   // Params per transaction (~70 bytes each)
+
+// Staged multi-parameter update. Values are range/type checked as they
+// are staged but stay invisible until commit(), which checks the
+// cross-parameter constraints (setpoint inside its limits, min <= max
+// pairs), publishes the values that differ from the current ones inside
+// one critical section and saves EEPROM once (only if a persisted value
+// changed). A failed commit applies nothing.
+class ParamTransaction {
+  public:
+    ParamTransaction();
+
+    void clear();
+    uint8_t size() const { return _count; }
+    ParamIndex indexAt(uint8_t i) const { return _entries[i].index; }
+
+    // Stage a value (checked by the type codec); returns nullptr or an error reason
+    const char* stage(ParamIndex index, const ParamValue& value);
+
+    // Parse text with the type codec and stage it
+    const char* stageText(ParamIndex index, const char* text);
+
+    // Cross-parameter checks on staged-over-current values. Only
+    // constraints touching a staged param are checked, so an already
+    // inconsistent stored config does not block unrelated updates.
+    const char* validate(ParamIndex* failed = nullptr) const;
+
+    // Validate and publish; returns nullptr or the reason (with the
+    // offending param in *failed)
+    const char* commit(ParamIndex* failed = nullptr);
+
+  private:
+    struct Entry {
+        ParamIndex index;
+        ParamValue value;
+    };
+
+    Entry _entries[PARAM_TX_MAX_ENTRIES];
+    uint8_t _count;
+
+    Entry* slotFor(ParamIndex index);
+    bool isStaged(ParamIndex index) const;
+    float effectiveFloat(ParamIndex index) const;
+    const char* checkOrdered(ParamIndex low, ParamIndex high, ParamIndex* failed) const;
+};
+
+#endif
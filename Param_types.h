@@ -23,6 +23,8 @@ enum ParamFlags {
     BLUETOOTH_ACCESS= 0x80,  // Included in Bluetooth
     NO_FLASH_SAVE   = 0x100, // Don't save to flash (RAM only)
     SECURED_VALUE   = 0x200, // Mask value when displaying (for passwords)
+    STREAM_ACCESS   = 0x400, // Pushed to /api/stream subscribers on change
+    COMPUTED        = 0x800, // Value comes from a getter on read, nothing stored
 };
 
 struct ConfigParam {
@@ -69,14 +71,27 @@ struct ConfigParam {
             bool default_value;
         } boolean;
         
+        // The characters live in the string arena (Param_helpers.cpp);
+        // offset and length are filled in by layoutParamStrings()
         struct {
-            char value[64];
-            size_t max_size;
+            uint16_t offset;
+            uint8_t length;             // Current length, terminator excluded
+            uint8_t max_size;           // Slot size, terminator included
             const char* default_value;
         } string;
     };
 };
 
+// A single parameter value detached from the table (staging, codecs)
+union ParamValue {
+    float number;
+    uint8_t uint8;
+    uint16_t uint16;
+    int16_t int16;
+    bool boolean;
+    char string[64];
+};
+
 // Parameter indices
 enum ParamIndex {
     // System
@@ -122,6 +137,87 @@ enum ParamIndex {
     PARAM_NTP_GMT_OFFSET, 
     PARAM_NTP_DAYLIGHT_OFFSET,
 
+    // Energy metering
+    PARAM_HEATER_WATTAGE,
+    PARAM_ENERGY_TOTAL,
+    PARAM_ENERGY_BATCH,
+    PARAM_BATCH_HEATER_HOURS,
+    PARAM_DUTY_1M,
+    PARAM_DUTY_1H,
+    PARAM_DUTY_24H,
+
+    // Multi-probe OneWire bus (per-role params are in role order:
+    // wort, jacket, ambient - see ProbeRole)
+    PARAM_TEMP_MULTI_PROBE,
+    PARAM_TEMP_PROBE_COUNT,
+    PARAM_TEMP_BUS_TIME,
+    PARAM_PROBE_WORT_ROM,
+    PARAM_PROBE_JACKET_ROM,
+    PARAM_PROBE_AMBIENT_ROM,
+    PARAM_PROBE_WORT_TEMP,
+    PARAM_PROBE_JACKET_TEMP,
+    PARAM_PROBE_AMBIENT_TEMP,
+    PARAM_PROBE_WORT_AGE,
+    PARAM_PROBE_JACKET_AGE,
+    PARAM_PROBE_AMBIENT_AGE,
+    PARAM_PROBE_WORT_ERRORS,
+    PARAM_PROBE_JACKET_ERRORS,
+    PARAM_PROBE_AMBIENT_ERRORS,
+
+    // Sensor filter pipeline
+    PARAM_TEMP_FILTER_CALIBRATION,
+    PARAM_TEMP_FILTER_MEDIAN,
+    PARAM_TEMP_FILTER_SLEW,
+    PARAM_TEMP_FILTER_EMA,
+    PARAM_TEMP_EMA_ALPHA,
+    PARAM_TEMP_MAX_SLEW,
+    PARAM_TEMP_REJECTED,
+    PARAM_TEMP_FILTER_TIME,
+
+    // Kalman state estimator
+    PARAM_KALMAN_ENABLED,
+    PARAM_HEATER_GAIN,
+    PARAM_KALMAN_MEAS_NOISE,
+    PARAM_KALMAN_PROC_NOISE,
+    PARAM_PID_PREDICT_HORIZON,
+    PARAM_EST_TEMP,
+    PARAM_EST_RATE,
+    PARAM_EST_LOSS,
+
+    // Adaptive sensor sampling
+    PARAM_SAMPLE_ADAPTIVE,
+    PARAM_SAMPLE_MIN_INTERVAL,
+    PARAM_SAMPLE_MAX_INTERVAL,
+    PARAM_SAMPLE_RATE_THRESHOLD,
+    PARAM_SAMPLES_PER_HOUR,
+
+    // API memory diagnostics
+    PARAM_ARENA_PEAK,
+    PARAM_ARENA_OVERFLOWS,
+    PARAM_HEAP_LARGEST_BLOCK,
+
+    // Event stream
+    PARAM_STREAM_INTERVAL,
+
+    // API connection reuse
+    PARAM_API_REQUESTS,
+    PARAM_API_CONNECTIONS,
+
+    // Derived values (COMPUTED)
+    PARAM_WIFI_RSSI,
+    PARAM_HEAP_FREE,
+    PARAM_TIME_TO_SETPOINT,
+
+    // Display and loop timing
+    PARAM_DISPLAY_MAX_FPS,
+    PARAM_DISPLAY_I2C_BPS,
+    PARAM_LOOP_TIME_US,
+    PARAM_DISPLAY_RENDER_US,
+    PARAM_DISPLAY_FLUSH_US,
+
+    // Wall clock
+    PARAM_TIME_SYNCED,
+
     PARAM_COUNT
 };
 
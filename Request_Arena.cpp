@@ -0,0 +1,62 @@
+#include "Request_Arena.h"
+#include <cJSON.h>
+
+alignas(REQUEST_ARENA_ALIGN) uint8_t RequestArena::_buffer[REQUEST_ARENA_SIZE];
+size_t RequestArena::_used = 0;
+size_t RequestArena::_peak = 0;
+uint16_t RequestArena::_overflows = 0;
+TaskHandle_t volatile RequestArena::_owner = nullptr;
+
+void RequestArena::installHooks() {
+    cJSON_Hooks hooks = { RequestArena::allocate, RequestArena::release };
+    cJSON_InitHooks(&hooks);
+}
+
+void* RequestArena::allocate(size_t size) {
+    if (_owner == nullptr || _owner != xTaskGetCurrentTaskHandle()) {
+        return malloc(size);   // cJSON user outside a request scope
+    }
+
+    size_t aligned = (size + REQUEST_ARENA_ALIGN - 1) & ~(size_t)(REQUEST_ARENA_ALIGN - 1);
+
+    if (aligned <= REQUEST_ARENA_SIZE - _used) {
+        void* ptr = _buffer + _used;
+        _used += aligned;
+        if (_used > _peak) _peak = _used;
+        return ptr;
+    }
+
+    // Arena exhausted: this request pays for a heap allocation
+    if (_overflows < UINT16_MAX) _overflows++;
+    return malloc(size);
+}
+
+void RequestArena::release(void* ptr) {
+    // Arena blocks go away together on reset()
+    if (ptr && !contains(ptr)) {
+        free(ptr);
+    }
+}
+
+void RequestArena::reset() {
+    _used = 0;
+}
+
+bool RequestArena::contains(const void* ptr) {
+    const uint8_t* p = (const uint8_t*)ptr;
+    return p >= _buffer && p < _buffer + REQUEST_ARENA_SIZE;
+}
+
+ArenaScope::ArenaScope() : _outermost(RequestArena::_owner == nullptr) {
+    if (!_outermost) return;   // Nested scope shares the outer request's arena
+
+    RequestArena::reset();
+    RequestArena::_owner = xTaskGetCurrentTaskHandle();
+}
+
+ArenaScope::~ArenaScope() {
+    if (!_outermost) return;
+
+    RequestArena::_owner = nullptr;
+    RequestArena::reset();
+}
@@ -0,0 +1,56 @@
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Config.h"
+
+#define REQUEST_ARENA_ALIGN 8
+
+// Bump-pointer arena for the allocations made while serving one API
+// request. Allocation is a pointer increment, free() of an arena block
+// is a no-op and the whole arena is reset in O(1) when the request ends.
+// Requests that do not fit fall back to the heap and are counted.
+// The HTTPS server runs handlers on a single task, so one arena suffices.
+class RequestArena {
+  public:
+    // Install the cJSON hooks once, before any task uses cJSON. They stay
+    // in place: only the task inside an ArenaScope is served from the
+    // arena, every other cJSON user keeps getting malloc/free.
+    static void installHooks();
+
+    static void* allocate(size_t size);
+    static void release(void* ptr);
+
+    // Forget every arena allocation (heap fallbacks are freed by their owners)
+    static void reset();
+
+    static bool contains(const void* ptr);
+    static size_t getUsed() { return _used; }
+    static size_t getPeak() { return _peak; }
+    static uint16_t getOverflows() { return _overflows; }
+
+  private:
+    friend class ArenaScope;
+
+    alignas(REQUEST_ARENA_ALIGN) static uint8_t _buffer[REQUEST_ARENA_SIZE];
+    static TaskHandle_t volatile _owner;   // Task inside the active scope
+    static size_t _used;
+    static size_t _peak;
+    static uint16_t _overflows;
+};
+
+// Routes the calling task's cJSON allocations into the request arena for
+// the lifetime of a handler, then resets the arena. Everything cJSON
+// returned inside the scope must be dead when it ends.
+class ArenaScope {
+  public:
+    ArenaScope();
+    ~ArenaScope();
+
+  private:
+    bool _outermost;
+};
+
+#endif
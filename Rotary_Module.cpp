@@ -1,6 +1,7 @@
 #include "Rotary_Module.h"
 #include "Display_Module.h"
 #include "Param_helpers.h"
+#include "Param_codec.h"
 #include "EEPROM_Manager.h"
 
 extern ConfigParam system_params[PARAM_COUNT];
@@ -157,42 +158,17 @@ void RotaryModule::handleParamEditMode() {
 }
 
 int RotaryModule::findFirstDisplayParam() {
-    for (int i = 0; i < PARAM_COUNT; i++) {
-        if (system_params[i].flags & DISPLAY_ACCESS) {
-            return i;
-        }
-    }
-    return 0;
+    ParamList list = getParamList(PARAM_LIST_DISPLAY);
+    return list.count ? list[0] : 0;
 }
 
 int RotaryModule::findFirstRotaryParam() {
-    for (int i = 0; i < PARAM_COUNT; i++) {
-        if (system_params[i].flags & DISPLAY_ACCESS && 
-            system_params[i].flags & ROTARY_ACCESS) {
-            return i;
-        }
-    }
-    return findFirstDisplayParam();
+    ParamList list = getParamList(PARAM_LIST_ROTARY);
+    return list.count ? list[0] : findFirstDisplayParam();
 }
 
 int RotaryModule::findNextParam(int direction) {
-    int startIndex = currentParamIndex;
-    int newIndex = currentParamIndex;
-    int attempts = 0;
-    
-    do {
-        newIndex += direction;
-        if (newIndex < 0) newIndex = PARAM_COUNT - 1;
-        if (newIndex >= PARAM_COUNT) newIndex = 0;
-        
-        if (system_params[newIndex].flags & DISPLAY_ACCESS) {
-            return newIndex;
-        }
-        
-        attempts++;
-    } while (newIndex != startIndex && attempts < PARAM_COUNT);
-    
-    return startIndex;
+    return paramListStep(PARAM_LIST_DISPLAY, currentParamIndex, direction);
 }
 
 bool RotaryModule::canEditCurrentParam() {
@@ -215,25 +191,9 @@ void RotaryModule::saveCurrentValue() {
             Serial.println("Parameter not saved to EEPROM (NO_FLASH_SAVE flag)");
         }
         
-        Serial.printf("SAVED: %s = ", param.name);
-        
-        switch (param.type) {
-            case TYPE_FLOAT:
-                Serial.printf("%.1f\n", getParamFloat(index));
-                break;
-            case TYPE_UINT8:
-                Serial.printf("%d\n", getParamUint8(index));
-                break;
-            case TYPE_UINT16:
-                Serial.printf("%d\n", getParamUint16(index));
-                break;
-            case TYPE_BOOL:
-                Serial.printf("%s\n", getParamBool(index) ? "ON" : "OFF");
-                break;
-            case TYPE_STRING:
-                Serial.printf("%s\n", getParamString(index));
-                break;
-        }
+        char text[PARAM_TEXT_SIZE];
+        formatParam(index, PARAM_FORMAT_DISPLAY, text, sizeof(text));
+        Serial.printf("SAVED: %s = %s\n", param.name, text);
     }
     
     displayModule.setSelectedParam(currentParamIndex);
@@ -256,77 +216,20 @@ void RotaryModule::handleEditRotation(int direction) {
     if (currentParamIndex >= 0 && currentParamIndex < PARAM_COUNT) {
         ParamIndex index = static_cast<ParamIndex>(currentParamIndex);
         ConfigParam& param = system_params[currentParamIndex];
+        const ParamCodec& codec = codecFor(param);
         
-        //Serial.printf("EDIT: %s, type=%d, dir=%d, ", param.name, param.type, direction);
-        
-        // Флаг что значение изменилось
-        static bool valueChanged = false;
-        static int lastChangedParam = -1;
-        
-        switch (param.type) {
-            case TYPE_FLOAT: {
-                float oldValue = getParamFloat(index);
-                float newFloat = oldValue + (direction * param.number.step);
-                newFloat = constrain(newFloat, param.number.min_value, param.number.max_value);
-                
-                Serial.printf("FLOAT: old=%.1f, new=%.1f", oldValue, newFloat);
-                
-                if (newFloat != oldValue) {
-                    setParamFloat(index, newFloat);
-                    valueChanged = true;
-                    lastChangedParam = currentParamIndex;
-                    Serial.println(" - CHANGED");
-                } else {
-                    Serial.println(" - NO CHANGE");
-                }
-                break;
-            }
-            case TYPE_UINT8: {
-                uint8_t oldValue = getParamUint8(index);
-                uint8_t newUint8 = oldValue + (direction * param.uint8.step);
-                newUint8 = constrain(newUint8, param.uint8.min_value, param.uint8.max_value);
-                
-                Serial.printf("UINT8: old=%d, new=%d", oldValue, newUint8);
-                
-                if (newUint8 != oldValue) {
-                    setParamUint8(index, newUint8);
-                    valueChanged = true;
-                    lastChangedParam = currentParamIndex;
-                    Serial.println(" - CHANGED");
-                } else {
-                    Serial.println(" - NO CHANGE");
-                }
-                break;
-            }
-            case TYPE_UINT16: {
-                uint16_t oldValue = getParamUint16(index);
-                uint16_t newUint16 = oldValue + (direction * param.uint16.step);
-                newUint16 = constrain(newUint16, param.uint16.min_value, param.uint16.max_value);
-                
-                Serial.printf("UINT16: old=%d, new=%d", oldValue, newUint16);
-                
-                if (newUint16 != oldValue) {
-                    setParamUint16(index, newUint16);
-                    valueChanged = true;
-                    lastChangedParam = currentParamIndex;
-                    Serial.println(" - CHANGED");
-                } else {
-                    Serial.println(" - NO CHANGE");
-                }
-                break;
-            }
-            case TYPE_BOOL: {
-                bool oldValue = getParamBool(index);
-                Serial.printf("BOOL: old=%s", oldValue ? "ON" : "OFF");
-                setParamBool(index, !oldValue);
-                valueChanged = true;
-                lastChangedParam = currentParamIndex;
-                Serial.println(" - CHANGED");
-                break;
-            }
-            default:
-                Serial.printf("UNKNOWN TYPE: %d\n", param.type);
-                break;
+        // One step per detent, clamped by the type codec
+        ParamValue value;
+        getParamValue(index, value);
+        codec.step(param, direction, value);
+
+        if (codec.equals(param, value)) {
+            Serial.println("NO CHANGE");
+        } else {
+            setParamValue(index, value);
+            char text[PARAM_TEXT_SIZE];
+            formatParam(index, PARAM_FORMAT_DISPLAY, text, sizeof(text));
+            Serial.printf("%s -> %s\n", param.name, text);
         }
         
         displayModule.setSelectedParam(currentParamIndex);
@@ -334,38 +237,11 @@ void RotaryModule::handleEditRotation(int direction) {
 }
 
 int RotaryModule::findNextDisplayParam(int direction) {
-    int startIndex = currentParamIndex;
-    int newIndex = currentParamIndex;
-    
-    do {
-        newIndex += direction;
-        if (newIndex < 0) newIndex = PARAM_COUNT - 1;
-        if (newIndex >= PARAM_COUNT) newIndex = 0;
-        
-        if (system_params[newIndex].flags & DISPLAY_ACCESS) {
-            return newIndex;
-        }
-    } while (newIndex != startIndex);
-    
-    return startIndex;
+    return paramListStep(PARAM_LIST_DISPLAY, currentParamIndex, direction);
 }
 
 int RotaryModule::findNextRotaryParam(int direction) {
-    int startIndex = currentParamIndex;
-    int newIndex = currentParamIndex;
-    
-    do {
-        newIndex += direction;
-        if (newIndex < 0) newIndex = PARAM_COUNT - 1;
-        if (newIndex >= PARAM_COUNT) newIndex = 0;
-        
-        if (system_params[newIndex].flags & DISPLAY_ACCESS && 
-            system_params[newIndex].flags & ROTARY_ACCESS) {
-            return newIndex;
-        }
-    } while (newIndex != startIndex);
-    
-    return startIndex;
+    return paramListStep(PARAM_LIST_ROTARY, currentParamIndex, direction);
 }
 
 void RotaryModule::handleParamScrollDisplayMode() {
@@ -0,0 +1,115 @@
+#include "SH1106_Dirty.h"
+
+SH1106DirtyWire::SH1106DirtyWire(uint8_t address, int sda, int scl)
+    : SH1106Wire(address, sda, scl), _address(address), _shadowValid(false), _busy(false),
+      _lastFlushUs(0), _bytesSent(0), _statsMux(portMUX_INITIALIZER_UNLOCKED), _task(nullptr) {}
+
+bool SH1106DirtyWire::beginAsync(UBaseType_t priority, uint32_t stackSize) {
+    if (_task) return true;
+    if (xTaskCreate(flushTask, "oled_flush", stackSize, this, priority, &_task) != pdPASS) {
+        _task = nullptr;
+        Serial.println("Display flush task failed, flushing synchronously");
+        return false;
+    }
+    return true;
+}
+
+void SH1106DirtyWire::display() {
+    // Once the task owns the bus, every frame goes through it
+    if (_task) {
+        submit();
+        return;
+    }
+    flush(buffer);
+}
+
+bool SH1106DirtyWire::submit() {
+    if (!_task) {
+        flush(buffer);
+        return true;
+    }
+    if (_busy) return false;
+
+    // The task only reads _front while _busy is set
+    memcpy(_front, buffer, SH1106_FRAME_SIZE);
+    _busy = true;
+    xTaskNotifyGive(_task);
+    return true;
+}
+
+void SH1106DirtyWire::flushTask(void* arg) {
+    SH1106DirtyWire* self = (SH1106DirtyWire*)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->flush(self->_front);
+        self->_busy = false;
+    }
+}
+
+uint32_t SH1106DirtyWire::takeBytesSent() {
+    portENTER_CRITICAL(&_statsMux);
+    uint32_t sent = _bytesSent;
+    _bytesSent = 0;
+    portEXIT_CRITICAL(&_statsMux);
+    return sent;
+}
+
+void SH1106DirtyWire::flush(const uint8_t* frame) {
+    uint32_t start = micros();
+
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        const uint8_t* row = frame + page * SH1106_WIDTH;
+        uint8_t* shadow = _shadow + page * SH1106_WIDTH;
+
+        int first = -1;
+        int last = -1;
+        for (int x = 0; x < SH1106_WIDTH; x++) {
+            if (!_shadowValid || row[x] != shadow[x]) {
+                if (first < 0) first = x;
+                last = x;
+            }
+        }
+        if (first < 0) continue;
+
+        writePageSpan(frame, page, first, last);
+        memcpy(shadow + first, row + first, last - first + 1);
+    }
+    _shadowValid = true;
+
+    _lastFlushUs = micros() - start;
+}
+
+void SH1106DirtyWire::writeCommand(uint8_t command) {
+    Wire.beginTransmission(_address);
+    Wire.write(0x80);       // Control byte: single command
+    Wire.write(command);
+    Wire.endTransmission();
+
+    portENTER_CRITICAL(&_statsMux);
+    _bytesSent += 3;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void SH1106DirtyWire::writePageSpan(const uint8_t* frame, uint8_t page, uint8_t first, uint8_t last) {
+    uint8_t column = first + SH1106_COLUMN_OFFSET;
+    writeCommand(0xB0 | page);
+    writeCommand(0x00 | (column & 0x0F));
+    writeCommand(0x10 | (column >> 4));
+
+    const uint8_t* data = frame + page * SH1106_WIDTH + first;
+    size_t remaining = last - first + 1;
+    while (remaining > 0) {
+        size_t n = remaining < SH1106_I2C_CHUNK ? remaining : SH1106_I2C_CHUNK;
+        Wire.beginTransmission(_address);
+        Wire.write(0x40);   // Control byte: data stream
+        Wire.write(data, n);
+        Wire.endTransmission();
+
+        portENTER_CRITICAL(&_statsMux);
+        _bytesSent += 2 + n;
+        portEXIT_CRITICAL(&_statsMux);
+
+        data += n;
+        remaining -= n;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef SH1106_DIRTY_H
+#define SH1106_DIRTY_H
+
+#include <SH1106Wire.h>
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define SH1106_WIDTH          128
+#define SH1106_PAGES          8     // 8-pixel rows, one byte per column each
+#define SH1106_FRAME_SIZE     (SH1106_WIDTH * SH1106_PAGES)
+#define SH1106_COLUMN_OFFSET  2     // 128 visible columns centred in 132 of RAM
+#define SH1106_I2C_CHUNK      32    // Data bytes per I2C transaction
+
+// SH1106Wire whose flush sends only what changed. A shadow copy of the
+// panel RAM is kept; per page, the span between the first and the last
+// differing column is written and everything else is skipped. An
+// unchanged frame costs no I2C traffic at all.
+//
+// After beginAsync() the flush runs on its own low-priority task: the
+// caller renders into the OLEDDisplay buffer (back buffer), submit()
+// copies it to the front buffer and wakes the task, and the caller never
+// touches the I2C bus. Before that (library init) display() flushes
+// synchronously. Panel commands (flip, contrast) belong before
+// beginAsync(): afterwards the task is the only user of the bus.
+class SH1106DirtyWire : public SH1106Wire {
+  public:
+    SH1106DirtyWire(uint8_t address, int sda, int scl);
+
+    // Start the flush task (call once after init())
+    bool beginAsync(UBaseType_t priority, uint32_t stackSize);
+
+    // Synchronous flush of the back buffer (library init path)
+    void display() override;
+
+    // Hand the rendered frame to the flush task. Returns false, and the
+    // frame is not taken, while the previous one is still being sent.
+    bool submit();
+
+    bool isFlushing() const { return _busy; }
+
+    // Next flush rewrites the whole panel
+    void invalidate() { _shadowValid = false; }
+
+    // I2C bytes sent (address, control and payload) since the last call
+    uint32_t takeBytesSent();
+    // Duration of the most recent flush
+    uint32_t getLastFlushUs() const { return _lastFlushUs; }
+
+  private:
+    uint8_t _address;
+    uint8_t _front[SH1106_FRAME_SIZE];     // Frame being flushed (task side)
+    uint8_t _shadow[SH1106_FRAME_SIZE];    // What the panel shows
+    bool _shadowValid;
+    volatile bool _busy;
+    volatile uint32_t _lastFlushUs;
+    uint32_t _bytesSent;
+    portMUX_TYPE _statsMux;
+    TaskHandle_t _task;
+
+    static void flushTask(void* arg);
+    void flush(const uint8_t* frame);
+    void writeCommand(uint8_t command);
+    void writePageSpan(const uint8_t* frame, uint8_t page, uint8_t first, uint8_t last);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "Sample_Scheduler.h"
+
+SampleScheduler::SampleScheduler() {
+  _lastRequest = 0;
+  _interval = 0;
+  _lastPower = 0;
+  _lastSetpoint = 0;
+  _powerGen = 0;
+  _setpointGen = 0;
+  _controlChanged = false;
+  _windowStart = 0;
+  _windowSamples = 0;
+}
+
+bool SampleScheduler::due(unsigned long now) {
+  if (controlChanged()) {
+    _controlChanged = true;
+  }
+
+  if (!getParamBool(PARAM_SAMPLE_ADAPTIVE)) {
+    _interval = getParamFloat(PARAM_UPDATE_INTERVAL);
+  } else if (_controlChanged) {
+    // Heater switched or setpoint moved: sample at the fast rate now
+    // rather than after the current (possibly backed-off) interval
+    _interval = min(_interval, (unsigned long)getParamFloat(PARAM_SAMPLE_MIN_INTERVAL));
+  }
+
+  if (now - _lastRequest < _interval) {
+    return false;
+  }
+  _lastRequest = now;
+  return true;
+}
+
+void SampleScheduler::onSample(unsigned long now) {
+  // Effective rate over a fixed window
+  _windowSamples++;
+  if (now - _windowStart >= SAMPLE_RATE_WINDOW) {
+    setParamFloat(PARAM_SAMPLES_PER_HOUR, _windowSamples * 3600000.0f / (now - _windowStart));
+    _windowStart = now;
+    _windowSamples = 0;
+  }
+
+  bool transient = isTransient();
+  if (!getParamBool(PARAM_SAMPLE_ADAPTIVE)) {
+    return;
+  }
+
+  unsigned long minInterval = getParamFloat(PARAM_SAMPLE_MIN_INTERVAL);
+  unsigned long maxInterval = getParamFloat(PARAM_SAMPLE_MAX_INTERVAL);
+  if (maxInterval < minInterval) maxInterval = minInterval;
+
+  if (transient) {
+    _interval = minInterval;
+  } else {
+    _interval = _interval * SAMPLE_BACKOFF_NUM / SAMPLE_BACKOFF_DEN;
+  }
+  _interval = constrain(_interval, minInterval, maxInterval);
+}
+
+// Heater switched or setpoint changed since the last call. The change
+// generations make this cheap enough for every due() poll; the values are
+// only compared (and latched) when one of them was actually written.
+bool SampleScheduler::controlChanged() {
+  uint32_t powerGen = getParamChangedGen(PARAM_POWER_LEVEL);
+  uint32_t setpointGen = getParamChangedGen(PARAM_TEMP_SETPOINT);
+  if (powerGen == _powerGen && setpointGen == _setpointGen) {
+    return false;
+  }
+  _powerGen = powerGen;
+  _setpointGen = setpointGen;
+
+  uint8_t power = getParamUint8(PARAM_POWER_LEVEL);
+  float setpoint = getParamFloat(PARAM_TEMP_SETPOINT);
+
+  bool switched = (power == 0) != (_lastPower == 0) ||
+                  abs((int)power - (int)_lastPower) >= SAMPLE_POWER_STEP;
+  bool setpointChanged = setpoint != _lastSetpoint;
+
+  // Small power steps accumulate until they add up to SAMPLE_POWER_STEP
+  if (switched) _lastPower = power;
+  _lastSetpoint = setpoint;
+  return switched || setpointChanged;
+}
+
+bool SampleScheduler::isTransient() {
+  bool changed = _controlChanged;
+  _controlChanged = false;
+  bool steep = fabs(getParamFloat(PARAM_EST_RATE)) > getParamFloat(PARAM_SAMPLE_RATE_THRESHOLD);
+  return changed || steep;
+}
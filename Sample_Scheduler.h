@@ -0,0 +1,45 @@
+#ifndef SAMPLE_SCHEDULER_H
+#define SAMPLE_SCHEDULER_H
+
+#include <Arduino.h>
+#include "Param_helpers.h"
+
+#define SAMPLE_BACKOFF_NUM       3        // Stable: interval *= 3/2
+#define SAMPLE_BACKOFF_DEN       2
+#define SAMPLE_POWER_STEP        10       // Power change (%) treated as a transient
+#define SAMPLE_RATE_WINDOW       600000UL // samples_per_hour accounting window (ms)
+
+// Decides when the next sensor sample is due. With sample_adaptive off it
+// follows the fixed update_interval; with it on, it drops to
+// sample_min_interval on transients (heater switched, setpoint changed,
+// |dT/dt| above sample_rate_threshold) and backs off geometrically to
+// sample_max_interval while the fermenter is stable.
+class SampleScheduler {
+  public:
+    SampleScheduler();
+
+    // True when a sample should be requested now
+    bool due(unsigned long now);
+
+    // Record a completed sample and schedule the next one
+    void onSample(unsigned long now);
+
+    unsigned long getInterval() const { return _interval; }
+
+  private:
+    unsigned long _lastRequest;
+    unsigned long _interval;
+    uint8_t _lastPower;
+    float _lastSetpoint;
+    uint32_t _powerGen;
+    uint32_t _setpointGen;
+    bool _controlChanged;     // Seen by due(), consumed by onSample()
+
+    unsigned long _windowStart;
+    uint16_t _windowSamples;
+
+    bool controlChanged();
+    bool isTransient();
+};
+
+#endif
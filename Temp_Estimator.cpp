@@ -0,0 +1,89 @@
+#include "Temp_Estimator.h"
+
+// Loss state drifts much slower than temperature
+#define LOSS_NOISE_RATIO 0.01f
+
+TempEstimator::TempEstimator() {
+  reset();
+}
+
+void TempEstimator::reset() {
+  _initialized = false;
+  _lastUpdate = 0;
+  _temp = 0;
+  _loss = 0;
+  _rate = 0;
+  _p00 = 1.0f;
+  _p01 = 0;
+  _p10 = 0;
+  _p11 = 1.0f;
+}
+
+void TempEstimator::update(const TempSample& measurement, uint8_t power) {
+  if (!measurement.valid) {
+    return;
+  }
+
+  float z = tempFxToFloat(measurement.value);
+  unsigned long now = millis();
+  float gain = getParamFloat(PARAM_HEATER_GAIN) / 60.0f / 100.0f;  // °C/s per %
+  float heating = gain * power;
+
+  if (!_initialized) {
+    _temp = z;
+    _loss = 0;
+    _rate = heating;
+    _p00 = 1.0f;
+    _p01 = 0;
+    _p10 = 0;
+    _p11 = 1.0f;
+    _lastUpdate = now;
+    _initialized = true;
+    publish();
+    return;
+  }
+
+  float dt = (now - _lastUpdate) / 1000.0f;
+  _lastUpdate = now;
+
+  float q = getParamFloat(PARAM_KALMAN_PROC_NOISE);
+  float r = getParamFloat(PARAM_KALMAN_MEAS_NOISE);
+  float qT = q * q * dt;
+  float qL = qT * LOSS_NOISE_RATIO * LOSS_NOISE_RATIO;
+
+  // Predict: x = F x + B u, P = F P F' + Q with F = [1 -dt; 0 1]
+  _temp += dt * (heating - _loss);
+  float p00 = _p00 - dt * (_p01 + _p10) + dt * dt * _p11 + qT;
+  float p01 = _p01 - dt * _p11;
+  float p10 = _p10 - dt * _p11;
+  float p11 = _p11 + qL;
+
+  // Update with H = [1 0]
+  float s = p00 + r * r;
+  float k0 = p00 / s;
+  float k1 = p10 / s;
+  float innovation = z - _temp;
+  _temp += k0 * innovation;
+  _loss += k1 * innovation;
+
+  _p00 = (1.0f - k0) * p00;
+  _p01 = (1.0f - k0) * p01;
+  _p10 = p10 - k1 * p00;
+  _p11 = p11 - k1 * p01;
+
+  _rate = heating - _loss;
+  publish();
+}
+
+TempSample TempEstimator::predict(float horizonSec) const {
+  TempSample sample;
+  sample.value = tempFxFromFloat(_temp + _rate * horizonSec);
+  sample.valid = _initialized;
+  return sample;
+}
+
+void TempEstimator::publish() {
+  setParamFloat(PARAM_EST_TEMP, _temp);
+  setParamFloat(PARAM_EST_RATE, _rate * 60.0f);
+  setParamFloat(PARAM_EST_LOSS, _loss * 60.0f);
+}
@@ -0,0 +1,44 @@
+#ifndef TEMP_ESTIMATOR_H
+#define TEMP_ESTIMATOR_H
+
+#include <Arduino.h>
+#include "Fixed_point.h"
+#include "Param_helpers.h"
+
+// Two-state Kalman estimator fusing the filtered temperature with the
+// known heater power. State is [T, L]: temperature and ambient loss
+// rate, with the model
+//   dT/dt = heater_gain * power - L
+// Fixed 2x2 covariance, constant cost per sample.
+class TempEstimator {
+  public:
+    TempEstimator();
+
+    // Feed one measurement and the heater power (%) applied since the
+    // previous one
+    void update(const TempSample& measurement, uint8_t power);
+
+    // Drop the state (next measurement re-initializes it)
+    void reset();
+
+    bool isValid() const { return _initialized; }
+    float getTemperature() const { return _temp; }
+    float getRate() const { return _rate; }   // °C/s
+    float getLoss() const { return _loss; }   // °C/s
+
+    // Temperature expected after horizonSec at the current rate
+    TempSample predict(float horizonSec) const;
+
+  private:
+    bool _initialized;
+    unsigned long _lastUpdate;
+
+    float _temp;
+    float _loss;
+    float _rate;
+    float _p00, _p01, _p10, _p11;   // Covariance
+
+    void publish();
+};
+
+#endif
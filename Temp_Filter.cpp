@@ -0,0 +1,128 @@
+#include "Temp_Filter.h"
+
+TempFilter::TempFilter() {
+  _calibration = 0;
+  _calibrationFx = 0;
+  _alpha = 0;
+  _alphaQ8 = 256;
+  _maxSlew = 0;
+  _maxSlewFx = 0;
+  _rejectCount = 0;
+  reset();
+}
+
+void TempFilter::reset() {
+  _windowPos = 0;
+  _windowFill = 0;
+  _lastAccepted = 0;
+  _lastAcceptedTime = 0;
+  _rejectRun = 0;
+  _emaState = 0;
+  _seeded = false;
+}
+
+TempSample TempFilter::process(const TempSample& input) {
+  if (!input.valid) {
+    return input;
+  }
+
+  unsigned long start = micros();
+  TempSample output = input;
+
+  if (getParamBool(PARAM_TEMP_FILTER_CALIBRATION)) {
+    float cal = getParamFloat(PARAM_TEMP_CALIBRATION);
+    if (cal != _calibration) {
+      _calibration = cal;
+      _calibrationFx = tempFxFromFloat(cal);
+    }
+    output.value += _calibrationFx;
+  }
+
+  if (getParamBool(PARAM_TEMP_FILTER_MEDIAN)) {
+    output.value = median(output.value);
+  }
+
+  unsigned long now = millis();
+  if (getParamBool(PARAM_TEMP_FILTER_SLEW) && !slewOk(output.value, now)) {
+    // Outlier: hold the last accepted value
+    output.value = _lastAccepted;
+  } else {
+    _lastAccepted = output.value;
+    _lastAcceptedTime = now;
+  }
+
+  if (getParamBool(PARAM_TEMP_FILTER_EMA)) {
+    output.value = ema(output.value);
+  } else {
+    _emaState = output.value << 8;
+  }
+
+  _seeded = true;
+  setParamFloat(PARAM_TEMP_FILTER_TIME, micros() - start);
+  return output;
+}
+
+temp_fx_t TempFilter::median(temp_fx_t value) {
+  _window[_windowPos] = value;
+  _windowPos = (_windowPos + 1) % TEMP_MEDIAN_WINDOW;
+  if (_windowFill < TEMP_MEDIAN_WINDOW) _windowFill++;
+
+  // Insertion sort of at most TEMP_MEDIAN_WINDOW values
+  temp_fx_t sorted[TEMP_MEDIAN_WINDOW];
+  for (uint8_t i = 0; i < _windowFill; i++) {
+    temp_fx_t v = _window[i];
+    int8_t j = i - 1;
+    while (j >= 0 && sorted[j] > v) {
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = v;
+  }
+  return sorted[_windowFill / 2];
+}
+
+bool TempFilter::slewOk(temp_fx_t value, unsigned long now) {
+  if (!_seeded) {
+    return true;
+  }
+
+  // Allowed step grows with the time since the last accepted sample
+  float maxSlew = getParamFloat(PARAM_TEMP_MAX_SLEW);
+  if (maxSlew != _maxSlew) {
+    _maxSlew = maxSlew;
+    _maxSlewFx = tempFxFromFloat(maxSlew);
+  }
+  int32_t limit = (int32_t)(((int64_t)_maxSlewFx * (now - _lastAcceptedTime)) / 1000);
+  if (limit < 1) limit = 1;
+
+  if (abs(value - _lastAccepted) <= limit) {
+    _rejectRun = 0;
+    return true;
+  }
+
+  _rejectCount++;
+  setParamUint16(PARAM_TEMP_REJECTED, _rejectCount);
+
+  // A real step change persists: accept it after a few rejections
+  if (++_rejectRun > TEMP_SLEW_MAX_REJECTS) {
+    _rejectRun = 0;
+    return true;
+  }
+  return false;
+}
+
+temp_fx_t TempFilter::ema(temp_fx_t value) {
+  float alpha = getParamFloat(PARAM_TEMP_EMA_ALPHA);
+  if (alpha != _alpha) {
+    _alpha = alpha;
+    _alphaQ8 = (int32_t)lroundf(alpha * 256);
+  }
+
+  int32_t target = value << 8;
+  if (!_seeded) {
+    _emaState = target;
+  } else {
+    _emaState += (int32_t)(((int64_t)_alphaQ8 * (target - _emaState)) >> 8);
+  }
+  return _emaState >> 8;
+}
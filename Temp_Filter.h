@@ -0,0 +1,54 @@
+#ifndef TEMP_FILTER_H
+#define TEMP_FILTER_H
+
+#include <Arduino.h>
+#include "Fixed_point.h"
+#include "Param_helpers.h"
+
+#define TEMP_MEDIAN_WINDOW     5   // Samples in the sliding median (odd)
+#define TEMP_SLEW_MAX_REJECTS  3   // Consecutive rejects before re-seeding
+
+// Constant-memory filter between the sensor and the controller, all in
+// fixed point. Stages run in this order and each one can be switched
+// off with its temp_filter_* param:
+//   calibration offset -> sliding median -> slew-rate rejection -> EMA
+class TempFilter {
+  public:
+    TempFilter();
+
+    // Filter one sample; invalid samples pass through untouched
+    TempSample process(const TempSample& input);
+
+    // Drop all filter state (next sample re-seeds every stage)
+    void reset();
+
+  private:
+    // Sliding median
+    temp_fx_t _window[TEMP_MEDIAN_WINDOW];
+    uint8_t _windowPos;
+    uint8_t _windowFill;
+
+    // Slew-rate rejection
+    temp_fx_t _lastAccepted;
+    unsigned long _lastAcceptedTime;
+    uint8_t _rejectRun;
+    uint16_t _rejectCount;
+
+    // EMA state keeps 8 extra fraction bits so small alphas don't stall
+    int32_t _emaState;
+    bool _seeded;
+
+    // Params converted to fixed point only when they change
+    float _calibration;
+    temp_fx_t _calibrationFx;
+    float _alpha;
+    int32_t _alphaQ8;
+    float _maxSlew;
+    temp_fx_t _maxSlewFx;   // per second
+
+    temp_fx_t median(temp_fx_t value);
+    bool slewOk(temp_fx_t value, unsigned long now);
+    temp_fx_t ema(temp_fx_t value);
+};
+
+#endif
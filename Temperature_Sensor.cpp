@@ -1,43 +1,231 @@
 #include "Temperature_Sensor.h"
 #include "config.h"
+#include "EEPROM_Manager.h"
 
-Temperature_Sensor::Temperature_Sensor(int pin) : oneWire(pin), sensors(&oneWire) {}
+extern EEPROMManager eepromManager;
+
+static const char* probeRoleNames[PROBE_ROLE_COUNT] = { "wort", "jacket", "ambient" };
+
+// ROM codes are stored as 16 hex characters
+static void formatRom(const uint8_t* address, char* out) {
+  for (uint8_t i = 0; i < 8; i++) {
+    sprintf(out + i * 2, "%02X", address[i]);
+  }
+  out[16] = '\0';
+}
+
+static bool parseRom(const char* text, uint8_t* address) {
+  if (strlen(text) != 16) return false;
+  for (uint8_t i = 0; i < 8; i++) {
+    char byteStr[3] = { text[i * 2], text[i * 2 + 1], '\0' };
+    char* end;
+    address[i] = (uint8_t)strtoul(byteStr, &end, 16);
+    if (*end != '\0') return false;
+  }
+  return true;
+}
+
+static ParamIndex probeParam(ParamIndex first, ProbeRole role) {
+  return static_cast<ParamIndex>(first + role);
+}
+
+Temperature_Sensor::Temperature_Sensor(int pin) : oneWire(pin), sensors(&oneWire) {
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    probes[r].assigned = false;
+    probes[r].romMissing = false;
+    probes[r].valid = false;
+    probes[r].value = 0;
+    probes[r].lastGoodRead = 0;
+    probes[r].errors = 0;
+  }
+}
 
 void Temperature_Sensor::begin() {
   sensors.begin();
-  if (sensors.getDeviceCount() == 0) {
+  deviceCount = sensors.getDeviceCount();
+  setParamUint8(PARAM_TEMP_PROBE_COUNT, deviceCount);
+  if (deviceCount == 0) {
     Serial.println("No temperature sensors found!");
     sensorFound = false;
     return;
   }
-  
-  if (!sensors.getAddress(tempDeviceAddress, 0)) {
+
+  if (assignProbes()) {
+    Serial.println("Probe mapping updated");
+    eepromManager.saveConfig();
+  }
+
+  // Jacket/ambient keep running without a wort probe; the controller
+  // sees an invalid wort sample instead
+  bool anyAssigned = false;
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    anyAssigned |= probes[r].assigned;
+  }
+  if (!anyAssigned) {
     Serial.println("Unable to find address for Temperature sensor"); 
     sensorFound = false;
     return;
   }
-  
-  sensors.setResolution(tempDeviceAddress, TEMP_SENSOR_PRECISION);
+  if (!probes[PROBE_WORT].assigned) {
+    Serial.println("Warning: no wort probe, control input unavailable");
+  }
+
+  // Same resolution on every device, conversions are started by broadcast
+  sensors.setResolution(TEMP_SENSOR_PRECISION);
+  sensors.setWaitForConversion(false);
+  conversionTime = sensors.millisToWaitForConversion(TEMP_SENSOR_PRECISION);
+
   sensorFound = true;
-  Serial.println("Temperature Sensor initialized");
+  Serial.printf("Temperature Sensor initialized (%d device(s) on bus)\n", deviceCount);
+  printProbes();
 }
 
-float Temperature_Sensor::readTemperature() {
-  if (!sensorFound) {
-    return -127.0;
+// Map discovered devices to roles. Single-probe mode takes device 0 as
+// the wort probe and ignores the stored ROMs. With temp_multi_probe set,
+// stored ROMs are matched first, then the remaining devices fill roles
+// that have no stored ROM, in discovery order. A role whose stored ROM is
+// not on the bus stays unassigned and keeps its ROM (a loose probe must
+// not be silently replaced by another device), except that a replaced
+// wort probe on a one-device bus is adopted.
+// Returns true if the stored mapping changed.
+bool Temperature_Sensor::assignProbes() {
+  if (!getParamBool(PARAM_TEMP_MULTI_PROBE)) {
+    probes[PROBE_WORT].assigned = deviceCount > 0 && sensors.getAddress(probes[PROBE_WORT].address, 0);
+    return false;
   }
-  
-  sensors.requestTemperatures();
-  float tempC = sensors.getTempC(tempDeviceAddress);
-  
-  if (tempC == DEVICE_DISCONNECTED_C) {
-    Serial.println("Error: Could not read temperature data");
-    return -127.0;
+
+  bool changed = false;
+  bool used[TEMP_MAX_BUS_DEVICES] = { false };
+  uint8_t count = min(deviceCount, (uint8_t)TEMP_MAX_BUS_DEVICES);
+
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    DeviceAddress stored;
+    const char* storedRom = getParamString(probeParam(PARAM_PROBE_WORT_ROM, (ProbeRole)r));
+    if (!parseRom(storedRom, stored)) continue;
+    for (uint8_t i = 0; i < count; i++) {
+      DeviceAddress address;
+      if (!used[i] && sensors.getAddress(address, i) && memcmp(address, stored, 8) == 0) {
+        memcpy(probes[r].address, address, 8);
+        probes[r].assigned = true;
+        used[i] = true;
+        break;
+      }
+    }
+    if (!probes[r].assigned) {
+      probes[r].romMissing = true;
+      Serial.printf("Warning: %s probe %s not found on the bus\n", probeRoleNames[r], storedRom);
+    }
+  }
+
+  if (probes[PROBE_WORT].romMissing && count == 1 && !used[0]) {
+    Serial.println("Adopting the only device on the bus as the wort probe");
+    probes[PROBE_WORT].romMissing = false;
+  }
+
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    if (probes[r].assigned || probes[r].romMissing) continue;
+    for (uint8_t i = 0; i < count; i++) {
+      if (!used[i] && sensors.getAddress(probes[r].address, i)) {
+        char romStr[17];
+        formatRom(probes[r].address, romStr);
+        setParamString(probeParam(PARAM_PROBE_WORT_ROM, (ProbeRole)r), romStr);
+        probes[r].assigned = true;
+        used[i] = true;
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  return changed;
+}
+
+void Temperature_Sensor::requestSample() {
+  if (!sensorFound || conversionPending) {
+    return;
+  }
+
+  unsigned long busStart = micros();
+  sensors.requestTemperatures();  // Skip ROM + Convert T: all probes at once
+  requestBusTime = micros() - busStart;
+
+  conversionStart = millis();
+  conversionPending = true;
+}
+
+bool Temperature_Sensor::update() {
+  if (!conversionPending || millis() - conversionStart < conversionTime) {
+    return false;
+  }
+  conversionPending = false;
+
+  unsigned long busStart = micros();
+  unsigned long now = millis();
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    Probe& probe = probes[r];
+    if (!probe.assigned) continue;
+
+    // Raw 1/128 °C straight from the scratchpad, no float conversion
+    int32_t raw = sensors.getTemp(probe.address);
+    if (raw == DEVICE_DISCONNECTED_RAW) {
+      Serial.printf("Error: Could not read %s probe\n", probeRoleNames[r]);
+      probe.valid = false;
+      probe.errors++;
+    } else {
+      probe.valid = true;
+      probe.value = raw;
+      probe.lastGoodRead = now;
+    }
+  }
+  unsigned long busTime = requestBusTime + (micros() - busStart);
+  setParamFloat(PARAM_TEMP_BUS_TIME, busTime / 1000.0f);
+
+  publishProbes();
+  return true;
+}
+
+void Temperature_Sensor::publishProbes() {
+  unsigned long now = millis();
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    const Probe& probe = probes[r];
+    if (!probe.assigned) continue;
+
+    ProbeRole role = (ProbeRole)r;
+    if (probe.valid) {
+      setParamFloat(probeParam(PARAM_PROBE_WORT_TEMP, role), tempFxToFloat(probe.value));
+    }
+    unsigned long age = probe.lastGoodRead ? (now - probe.lastGoodRead) / 1000 : 65535;
+    setParamUint16(probeParam(PARAM_PROBE_WORT_AGE, role), min(age, 65535UL));
+    setParamUint16(probeParam(PARAM_PROBE_WORT_ERRORS, role), probe.errors);
   }
-  
-  return tempC;
+}
+
+TempSample Temperature_Sensor::getSample(ProbeRole role) {
+  TempSample sample;
+  sample.value = probes[role].value;
+  sample.valid = sensorFound && probes[role].valid;
+  return sample;
 }
 
 bool Temperature_Sensor::isSensorConnected() {
   return sensorFound;
-}
\ No newline at end of file
+}
+
+void Temperature_Sensor::printProbes() {
+  Serial.printf("OneWire bus: %d device(s), conversion %d ms\n", deviceCount, conversionTime);
+  for (uint8_t r = 0; r < PROBE_ROLE_COUNT; r++) {
+    if (!probes[r].assigned) {
+      if (probes[r].romMissing) {
+        Serial.printf("  %-8s %s  (missing)\n", probeRoleNames[r],
+                      getParamString(probeParam(PARAM_PROBE_WORT_ROM, (ProbeRole)r)));
+      } else {
+        Serial.printf("  %-8s (not assigned)\n", probeRoleNames[r]);
+      }
+      continue;
+    }
+    char romStr[17];
+    formatRom(probes[r].address, romStr);
+    Serial.printf("  %-8s %s  %.2f C  errors=%d\n", probeRoleNames[r], romStr,
+                  tempFxToFloat(probes[r].value), probes[r].errors);
+  }
+}
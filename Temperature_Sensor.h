@@ -4,19 +4,62 @@
 #include <OneWire.h>
 #include <DallasTemperature.h>
 #include "param_helpers.h"
+#include "Config.h"
+#include "Fixed_point.h"
+
+// Probe roles on the shared OneWire bus. The ROM-to-role mapping is
+// kept in the probe_*_rom params so it survives reboots.
+enum ProbeRole {
+    PROBE_WORT,
+    PROBE_JACKET,
+    PROBE_AMBIENT,
+    PROBE_ROLE_COUNT
+};
 
 class Temperature_Sensor {
   private:
+    struct Probe {
+      DeviceAddress address;
+      bool assigned;
+      bool romMissing;     // Stored ROM not on the bus (mapping kept)
+      bool valid;
+      temp_fx_t value;
+      unsigned long lastGoodRead;
+      uint16_t errors;
+    };
+
     OneWire oneWire;
     DallasTemperature sensors;
-    DeviceAddress tempDeviceAddress;
+    Probe probes[PROBE_ROLE_COUNT];
     bool sensorFound = false;
+    uint8_t deviceCount = 0;
+
+    // Conversion state: one broadcast Convert T serves every probe
+    bool conversionPending = false;
+    unsigned long conversionStart = 0;
+    uint16_t conversionTime = 0;
+    unsigned long requestBusTime = 0;  // us spent issuing the broadcast
+
+    bool assignProbes();
+    void publishProbes();
 
   public:
     Temperature_Sensor(int pin);
     void begin();
-    float readTemperature();
+
+    // Issue one broadcast conversion for all probes (returns immediately)
+    void requestSample();
+
+    // Call every loop(): reads all probes in one pass once the conversion
+    // time has elapsed. Returns true when a fresh sample is available.
+    bool update();
+
+    // Latest raw sample of a probe (calibration and filtering are
+    // applied downstream by TempFilter)
+    TempSample getSample(ProbeRole role = PROBE_WORT);
     bool isSensorConnected();
+    uint8_t getDeviceCount() { return deviceCount; }
+    void printProbes();
 };
 
-#endif
\ No newline at end of file
+#endif
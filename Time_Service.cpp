@@ -0,0 +1,46 @@
+#include "Time_Service.h"
+#include <esp_timer.h>
+
+TimeService timeService;
+
+TimeService::TimeService()
+    : _synced(false), _offsetUs(0), _nextRefreshUs(0), _lastPoll(0) {
+    strcpy(_hhmm, "00:00");
+}
+
+void TimeService::update() {
+    int64_t monoUs = esp_timer_get_time();
+
+    if (!_synced) {
+        if (millis() - _lastPoll < TIME_SYNC_POLL_MS) return;
+        _lastPoll = millis();
+
+        time_t wall = time(nullptr);    // Never blocks, unlike getLocalTime()
+        if (wall < TIME_VALID_EPOCH) return;
+
+        _synced = true;
+        refresh(wall, monoUs);
+        return;
+    }
+
+    if (monoUs >= _nextRefreshUs) {
+        refresh(time(nullptr), monoUs);
+    }
+}
+
+time_t TimeService::now() const {
+    if (!_synced) return 0;
+    return (time_t)((esp_timer_get_time() + _offsetUs) / 1000000);
+}
+
+// Re-anchor the offset (picks up SNTP corrections once a minute) and
+// reformat the cached HH:MM
+void TimeService::refresh(time_t wall, int64_t monoUs) {
+    _offsetUs = (int64_t)wall * 1000000 - monoUs;
+
+    struct tm local;
+    localtime_r(&wall, &local);
+    strftime(_hhmm, sizeof(_hhmm), "%H:%M", &local);
+
+    _nextRefreshUs = monoUs + (int64_t)(60 - local.tm_sec) * 1000000;
+}
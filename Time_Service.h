@@ -0,0 +1,39 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <Arduino.h>
+#include <time.h>
+
+#define TIME_VALID_EPOCH    1609459200   // 2021-01-01: anything earlier is "not synced yet"
+#define TIME_SYNC_POLL_MS   1000         // Sync check period until the first sync
+
+// Wall clock for the display and telemetry without getLocalTime(), which
+// waits up to 5 s while SNTP has not synced. update() (loop task) polls
+// the system clock without blocking. Once it is valid, the service keeps
+// the offset between the monotonic esp_timer clock and wall time and
+// reformats "HH:MM" only at minute rollover. Readers get a cached value.
+class TimeService {
+  public:
+    TimeService();
+
+    void update();
+
+    bool isSynced() const { return _synced; }
+    // Local "HH:MM", "00:00" until the first sync
+    const char* getHHMM() const { return _hhmm; }
+    // Seconds since the epoch, 0 until the first sync
+    time_t now() const;
+
+  private:
+    bool _synced;
+    int64_t _offsetUs;          // Wall clock minus esp_timer, in microseconds
+    int64_t _nextRefreshUs;     // esp_timer time of the next minute rollover
+    unsigned long _lastPoll;
+    char _hhmm[6];
+
+    void refresh(time_t wall, int64_t monoUs);
+};
+
+extern TimeService timeService;
+
+#endif
@@ -1,206 +1,567 @@
 #include "Param_types.h"
+#include "Param_access.h"
+#include "Config.h"
 
 ConfigParam system_params[PARAM_COUNT] = {
     // System
     [PARAM_VERSION] = {
-        "version", "Config version", TYPE_UINT8, 
+        "version", "Config version", PARAM_TYPE(PARAM_VERSION), 
 		SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS,
         {.uint8 = {1, 1, 255, 1, 1}}
     },
 
     [PARAM_UPTIME] = {
-        "uptime", "Uptime", TYPE_STRING,
-		SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
-        {.string = {"", 12, ""}}
+        "uptime", "Uptime", PARAM_TYPE(PARAM_UPTIME),
+		SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {.string = {0, 0, 12, ""}}
     },
     
     [PARAM_POWER_LEVEL] = {
-        "power_level", "Manual power level (%)", TYPE_UINT8, 
-        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        "power_level", "Manual power level (%)", PARAM_TYPE(PARAM_POWER_LEVEL), 
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS | STREAM_ACCESS,
         {.uint8 = {0, 0, 100, 1, 0}}
     },
     
     // Temperature Configuration
     [PARAM_TEMP_SETPOINT] = {
-        "temp_setpoint", "Temperature setpoint", TYPE_FLOAT, 
-        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        "temp_setpoint", "Temperature setpoint", PARAM_TYPE(PARAM_TEMP_SETPOINT), 
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS | STREAM_ACCESS,
         {25.0, 0.0, 100.0, 1.0, 25.0}
     },
     
     [PARAM_TEMP_SETPOINT_MIN] = {
-        "temp_setpoint_min", "Min temperature setpoint", TYPE_FLOAT, 
+        "temp_setpoint_min", "Min temperature setpoint", PARAM_TYPE(PARAM_TEMP_SETPOINT_MIN), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {0.0, 0.0, 50.0, 0.1, 0.0}  // TEMP_SETPOINT_MIN
     },
     
     [PARAM_TEMP_SETPOINT_MAX] = {
-        "temp_setpoint_max", "Max temperature setpoint", TYPE_FLOAT, 
+        "temp_setpoint_max", "Max temperature setpoint", PARAM_TYPE(PARAM_TEMP_SETPOINT_MAX), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {100.0, 50.0, 100.0, 0.1, 100.0}  // TEMP_SETPOINT_MAX
     },
     
     [PARAM_TEMP_HYSTERESIS] = {
-        "temp_hysteresis", "Temperature hysteresis", TYPE_FLOAT, 
+        "temp_hysteresis", "Temperature hysteresis", PARAM_TYPE(PARAM_TEMP_HYSTERESIS), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {0.5, 0.1, 5.0, 0.1, 0.5}  // TEMP_HYSTERESIS
     },
     
     [PARAM_CURRENT_TEMP] = {
-        "current_temp", "Current temperature", TYPE_FLOAT, 
-        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        "current_temp", "Current temperature", PARAM_TYPE(PARAM_CURRENT_TEMP), 
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
         {0.0, -50.0, 150.0, 0.1, 0.0}
     },
     
     [PARAM_TEMP_CALIBRATION] = {
-        "temp_calibration", "Temperature calibration", TYPE_FLOAT, 
+        "temp_calibration", "Temperature calibration", PARAM_TYPE(PARAM_TEMP_CALIBRATION), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
-        {0.0, -10.0, 10.0, 0.1, 0.0}
+        {TEMP_CALIBRATION_OFFSET, -10.0, 10.0, 0.1, TEMP_CALIBRATION_OFFSET}
     },
     
     [PARAM_TEMP_SENSOR_TYPE] = {
-        "temp_sensor_type", "Temperature sensor type", TYPE_UINT8, 
+        "temp_sensor_type", "Temperature sensor type", PARAM_TYPE(PARAM_TEMP_SENSOR_TYPE), 
         SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS,
         {.uint8 = {0, 0, 2, 1, 0}}  // 0=DS18B20, 1=DHT22, 2=NTC
     },
     
     [PARAM_UPDATE_INTERVAL] = {
-        "Sensors update_interval", "Sensors update interval (ms)", TYPE_FLOAT,
+        "Sensors update_interval", "Sensors update interval (ms)", PARAM_TYPE(PARAM_UPDATE_INTERVAL),
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {1000.0, 100.0, 10000.0, 100.0, 1000.0}
     },
 	[PARAM_HEATER_ENABLED] = {
-        "heater_enabled", "Heater enabled", TYPE_BOOL,
+        "heater_enabled", "Heater enabled", PARAM_TYPE(PARAM_HEATER_ENABLED),
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
         {.boolean = {true, true}}  // value=true, default=true
     },
 
     // PID Configuration (перенесено из config.h)
     [PARAM_PID_KP] = {
-        "pid_kp", "PID proportional gain", TYPE_FLOAT, 
+        "pid_kp", "PID proportional gain", PARAM_TYPE(PARAM_PID_KP), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {2.0, 0.0, 100.0, 0.1, 2.0}
     },
     
     [PARAM_PID_KI] = {
-        "pid_ki", "PID integral gain", TYPE_FLOAT, 
+        "pid_ki", "PID integral gain", PARAM_TYPE(PARAM_PID_KI), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {0.5, 0.0, 10.0, 0.01, 0.5}
     },
     
     [PARAM_PID_KD] = {
-        "pid_kd", "PID derivative gain", TYPE_FLOAT, 
+        "pid_kd", "PID derivative gain", PARAM_TYPE(PARAM_PID_KD), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {1.0, 0.0, 10.0, 0.1, 1.0}
     },
     
     [PARAM_PID_SAMPLE_TIME] = {
-        "pid_sample_time", "PID sample time (ms)", TYPE_FLOAT, 
+        "pid_sample_time", "PID sample time (ms)", PARAM_TYPE(PARAM_PID_SAMPLE_TIME), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {1000.0, 100.0, 10000.0, 100.0, 1000.0}  // PID_SAMPLE_TIME
     },
     
     [PARAM_PID_MAX_POWER] = {
-        "pid_max_power", "PID maximum power (%)", TYPE_FLOAT, 
+        "pid_max_power", "PID maximum power (%)", PARAM_TYPE(PARAM_PID_MAX_POWER), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {80.0, 0.0, 100.0, 1.0, 80.0}  // PID_MAX_POWER
     },
     
     [PARAM_PID_MIN_POWER] = {
-        "pid_min_power", "PID minimum power (%)", TYPE_FLOAT, 
+        "pid_min_power", "PID minimum power (%)", PARAM_TYPE(PARAM_PID_MIN_POWER), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {0.0, 0.0, 100.0, 1.0, 0.0}  // PID_MIN_POWER
     },
     
     [PARAM_PID_MAX_TEMP_DIFF] = {
-        "pid_max_temp_diff", "PID maximum temperature difference", TYPE_FLOAT, 
+        "pid_max_temp_diff", "PID maximum temperature difference", PARAM_TYPE(PARAM_PID_MAX_TEMP_DIFF), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {5.0, 0.1, 20.0, 0.1, 5.0}  // PID_MAX_TEMP_DIFF
     },
     
     [PARAM_PID_MIN_TEMP_DIFF] = {
-        "pid_min_temp_diff", "PID minimum temperature difference", TYPE_FLOAT, 
+        "pid_min_temp_diff", "PID minimum temperature difference", PARAM_TYPE(PARAM_PID_MIN_TEMP_DIFF), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {1.0, 0.1, 10.0, 0.1, 1.0}  // PID_MIN_TEMP_DIFF
     },
     
     [PARAM_PID_SWITCHING_DELTA] = {
-        "pid_switching_delta", "PID switching delta", TYPE_FLOAT, 
+        "pid_switching_delta", "PID switching delta", PARAM_TYPE(PARAM_PID_SWITCHING_DELTA), 
         SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {5.0, 0.1, 10.0, 0.1, 5.0}  // PID_SWITCHING_DELTA
     },
     
     [PARAM_HEATER_RUNNING] = {
-        "heater_running", "Heater running", TYPE_BOOL, 
-        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        "heater_running", "Heater running", PARAM_TYPE(PARAM_HEATER_RUNNING), 
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
         {.boolean = {false, false}}
     },
 	
 	    [PARAM_OPERATING_MODE] = {
-        "operating_mode", "Operating mode (0=Manual, 1=Auto)", TYPE_UINT8, 
-        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        "operating_mode", "Operating mode (0=Manual, 1=Auto)", PARAM_TYPE(PARAM_OPERATING_MODE), 
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS | STREAM_ACCESS,
         {.uint8 = {1, 0, 1, 1, 1}}  // value=1, min=0, max=1, step=1, default=1 (Auto)
     },	
     
     // Network settings (перенесено из ConfigData)
     [PARAM_WIFI_SSID] = {
-        "wifi_ssid", "WiFi SSID", TYPE_STRING,
+        "wifi_ssid", "WiFi SSID", PARAM_TYPE(PARAM_WIFI_SSID),
 		SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS,
-        {.string = {"wifi", 32, "wifi"}}
+        {.string = {0, 0, 32, "wifi"}}
     },
     
     [PARAM_WIFI_PASSWORD] = {
-        "wifi_password", "WiFi password", TYPE_STRING,
+        "wifi_password", "WiFi password", PARAM_TYPE(PARAM_WIFI_PASSWORD),
 		SERIAL_MENU | API_ACCESS| SECURED_VALUE,
-        {.string = {"passw", 64, "passw"}}
+        {.string = {0, 0, 64, "passw"}}
     },
     
     [PARAM_MQTT_SERVER] = {
-        "mqtt_server", "MQTT server", TYPE_STRING,
+        "mqtt_server", "MQTT server", PARAM_TYPE(PARAM_MQTT_SERVER),
 		SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS,
-        {.string = {"", 64, ""}}
+        {.string = {0, 0, 64, ""}}
     },
     
     [PARAM_MQTT_PORT] = {
-        "mqtt_port", "MQTT port", TYPE_UINT16,
+        "mqtt_port", "MQTT port", PARAM_TYPE(PARAM_MQTT_PORT),
 		SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS,
         {.uint16 = {1883, 1, 65535, 1, 1883}}
     },
     
     [PARAM_API_TOKEN] = {
-        "api_token", "API token", TYPE_STRING,
+        "api_token", "API token", PARAM_TYPE(PARAM_API_TOKEN),
 		SERIAL_MENU | API_ACCESS| SECURED_VALUE,
-        {.string = {"my_token-102938", 33, "my_token-102938"}}
+        {.string = {0, 0, 33, "my_token-102938"}}
     },
     
     [PARAM_HTTPS_ENABLED] = {
-        "https_enabled", "HTTPS enabled", TYPE_BOOL,
+        "https_enabled", "HTTPS enabled", PARAM_TYPE(PARAM_HTTPS_ENABLED),
 		SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {.boolean = {true, true}}
     },
     
     [PARAM_HTTPS_PORT] = {
-        "https_port", "HTTPS port", TYPE_UINT16,
+        "https_port", "HTTPS port", PARAM_TYPE(PARAM_HTTPS_PORT),
 		SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
         {.uint16 = {443, 1, 65535, 1, 443}}
     },
 
     // NTP Configuration
     [PARAM_NTP_SERVER] = {
-        "ntp_server", "NTP server", TYPE_STRING,
+        "ntp_server", "NTP server", PARAM_TYPE(PARAM_NTP_SERVER),
         SERIAL_MENU | API_ACCESS | DISPLAY_ACCESS,
-        {.string = {"time.google.com", 64, "time.google.com"}}
+        {.string = {0, 0, 64, "time.google.com"}}
     },
 
     [PARAM_NTP_GMT_OFFSET] = {
-        "ntp_gmt_offset", "GMT offset (hours)", TYPE_INT16,
+        "ntp_gmt_offset", "GMT offset (hours)", PARAM_TYPE(PARAM_NTP_GMT_OFFSET),
         SERIAL_MENU | API_ACCESS | DISPLAY_ACCESS,
         {.int16 = {0, -12, 12, 1, 0}}  // -12 to +12 hours
     },
 
     [PARAM_NTP_DAYLIGHT_OFFSET] = {
-        "ntp_daylight_offset", "Daylight offset (hours)", TYPE_INT16, 
+        "ntp_daylight_offset", "Daylight offset (hours)", PARAM_TYPE(PARAM_NTP_DAYLIGHT_OFFSET), 
         SERIAL_MENU | API_ACCESS | DISPLAY_ACCESS,
         {.int16 = {1, 0, 2, 1, 1}}  // 0 to 2 hours
+    },
+
+    // Energy metering (derived from fired half-waves)
+    [PARAM_HEATER_WATTAGE] = {
+        "heater_wattage", "Heater rated power (W)", PARAM_TYPE(PARAM_HEATER_WATTAGE),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {200.0, 0.0, 5000.0, 10.0, 200.0}
+    },
+
+    [PARAM_ENERGY_TOTAL] = {
+        "energy_total_wh", "Energy since boot (Wh)", PARAM_TYPE(PARAM_ENERGY_TOTAL),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 1.0e9, 0.1, 0.0}
+    },
+
+    [PARAM_ENERGY_BATCH] = {
+        "energy_batch_wh", "Energy this batch (Wh)", PARAM_TYPE(PARAM_ENERGY_BATCH),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 1.0e9, 0.1, 0.0}
+    },
+
+    [PARAM_BATCH_HEATER_HOURS] = {
+        "batch_heater_hours", "Full-power heater hours this batch", PARAM_TYPE(PARAM_BATCH_HEATER_HOURS),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 1.0e6, 0.01, 0.0}
+    },
+
+    [PARAM_DUTY_1M] = {
+        "duty_1m", "Heater duty cycle, 1 min avg (%)", PARAM_TYPE(PARAM_DUTY_1M),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 100.0, 0.1, 0.0}
+    },
+
+    [PARAM_DUTY_1H] = {
+        "duty_1h", "Heater duty cycle, 1 h avg (%)", PARAM_TYPE(PARAM_DUTY_1H),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 100.0, 0.1, 0.0}
+    },
+
+    [PARAM_DUTY_24H] = {
+        "duty_24h", "Heater duty cycle, 24 h avg (%)", PARAM_TYPE(PARAM_DUTY_24H),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 100.0, 0.1, 0.0}
+    },
+
+    // Multi-probe OneWire bus
+    [PARAM_TEMP_MULTI_PROBE] = {
+        "temp_multi_probe", "Use wort/jacket/ambient probes", PARAM_TYPE(PARAM_TEMP_MULTI_PROBE),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS,
+        {.boolean = {false, false}}
+    },
+
+    [PARAM_TEMP_PROBE_COUNT] = {
+        "temp_probe_count", "OneWire devices found", PARAM_TYPE(PARAM_TEMP_PROBE_COUNT),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {.uint8 = {0, 0, 255, 1, 0}}
+    },
+
+    [PARAM_TEMP_BUS_TIME] = {
+        "temp_bus_time", "OneWire bus time per sample (ms)", PARAM_TYPE(PARAM_TEMP_BUS_TIME),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 10000.0, 0.1, 0.0}
+    },
+
+    [PARAM_PROBE_WORT_ROM] = {
+        "probe_wort_rom", "Wort probe ROM code (hex)", PARAM_TYPE(PARAM_PROBE_WORT_ROM),
+        SERIAL_MENU | API_ACCESS,
+        {.string = {0, 0, 17, ""}}
+    },
+
+    [PARAM_PROBE_JACKET_ROM] = {
+        "probe_jacket_rom", "Jacket probe ROM code (hex)", PARAM_TYPE(PARAM_PROBE_JACKET_ROM),
+        SERIAL_MENU | API_ACCESS,
+        {.string = {0, 0, 17, ""}}
+    },
+
+    [PARAM_PROBE_AMBIENT_ROM] = {
+        "probe_ambient_rom", "Ambient probe ROM code (hex)", PARAM_TYPE(PARAM_PROBE_AMBIENT_ROM),
+        SERIAL_MENU | API_ACCESS,
+        {.string = {0, 0, 17, ""}}
+    },
+
+    [PARAM_PROBE_WORT_TEMP] = {
+        "probe_wort_temp", "Wort probe temperature", PARAM_TYPE(PARAM_PROBE_WORT_TEMP),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
+        {0.0, -55.0, 125.0, 0.1, 0.0}
+    },
+
+    [PARAM_PROBE_JACKET_TEMP] = {
+        "probe_jacket_temp", "Jacket probe temperature", PARAM_TYPE(PARAM_PROBE_JACKET_TEMP),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
+        {0.0, -55.0, 125.0, 0.1, 0.0}
+    },
+
+    [PARAM_PROBE_AMBIENT_TEMP] = {
+        "probe_ambient_temp", "Ambient probe temperature", PARAM_TYPE(PARAM_PROBE_AMBIENT_TEMP),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
+        {0.0, -55.0, 125.0, 0.1, 0.0}
+    },
+
+    [PARAM_PROBE_WORT_AGE] = {
+        "probe_wort_age", "Wort probe reading age (s)", PARAM_TYPE(PARAM_PROBE_WORT_AGE),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {65535, 0, 65535, 1, 65535}}
+    },
+
+    [PARAM_PROBE_JACKET_AGE] = {
+        "probe_jacket_age", "Jacket probe reading age (s)", PARAM_TYPE(PARAM_PROBE_JACKET_AGE),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {65535, 0, 65535, 1, 65535}}
+    },
+
+    [PARAM_PROBE_AMBIENT_AGE] = {
+        "probe_ambient_age", "Ambient probe reading age (s)", PARAM_TYPE(PARAM_PROBE_AMBIENT_AGE),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {65535, 0, 65535, 1, 65535}}
+    },
+
+    [PARAM_PROBE_WORT_ERRORS] = {
+        "probe_wort_errors", "Wort probe read errors", PARAM_TYPE(PARAM_PROBE_WORT_ERRORS),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {0, 0, 65535, 1, 0}}
+    },
+
+    [PARAM_PROBE_JACKET_ERRORS] = {
+        "probe_jacket_errors", "Jacket probe read errors", PARAM_TYPE(PARAM_PROBE_JACKET_ERRORS),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {0, 0, 65535, 1, 0}}
+    },
+
+    [PARAM_PROBE_AMBIENT_ERRORS] = {
+        "probe_ambient_errors", "Ambient probe read errors", PARAM_TYPE(PARAM_PROBE_AMBIENT_ERRORS),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {0, 0, 65535, 1, 0}}
+    },
+
+    // Sensor filter pipeline (calibration -> median -> slew -> EMA)
+    [PARAM_TEMP_FILTER_CALIBRATION] = {
+        "temp_filter_calibration", "Apply calibration offset", PARAM_TYPE(PARAM_TEMP_FILTER_CALIBRATION),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.boolean = {true, true}}
+    },
+
+    [PARAM_TEMP_FILTER_MEDIAN] = {
+        "temp_filter_median", "Median spike filter", PARAM_TYPE(PARAM_TEMP_FILTER_MEDIAN),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.boolean = {true, true}}
+    },
+
+    [PARAM_TEMP_FILTER_SLEW] = {
+        "temp_filter_slew", "Slew-rate outlier rejection", PARAM_TYPE(PARAM_TEMP_FILTER_SLEW),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.boolean = {true, true}}
+    },
+
+    [PARAM_TEMP_FILTER_EMA] = {
+        "temp_filter_ema", "Exponential smoothing", PARAM_TYPE(PARAM_TEMP_FILTER_EMA),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.boolean = {true, true}}
+    },
+
+    [PARAM_TEMP_EMA_ALPHA] = {
+        "temp_ema_alpha", "Smoothing factor (1 = none)", PARAM_TYPE(PARAM_TEMP_EMA_ALPHA),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {TEMP_SMOOTHING_FACTOR, 0.01, 1.0, 0.01, TEMP_SMOOTHING_FACTOR}
+    },
+
+    [PARAM_TEMP_MAX_SLEW] = {
+        "temp_max_slew", "Max plausible rate (C/s)", PARAM_TYPE(PARAM_TEMP_MAX_SLEW),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {0.5, 0.01, 10.0, 0.01, 0.5}
+    },
+
+    [PARAM_TEMP_REJECTED] = {
+        "temp_rejected", "Samples rejected as outliers", PARAM_TYPE(PARAM_TEMP_REJECTED),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {.uint16 = {0, 0, 65535, 1, 0}}
+    },
+
+    [PARAM_TEMP_FILTER_TIME] = {
+        "temp_filter_time", "Filter cost per sample (us)", PARAM_TYPE(PARAM_TEMP_FILTER_TIME),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 100000.0, 1.0, 0.0}
+    },
+
+    // Kalman state estimator
+    [PARAM_KALMAN_ENABLED] = {
+        "kalman_enabled", "Use Kalman estimate in controller", PARAM_TYPE(PARAM_KALMAN_ENABLED),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.boolean = {false, false}}
+    },
+
+    [PARAM_HEATER_GAIN] = {
+        "heater_gain", "Heating rate at 100% power (C/min)", PARAM_TYPE(PARAM_HEATER_GAIN),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {0.05, 0.0, 10.0, 0.01, 0.05}
+    },
+
+    [PARAM_KALMAN_MEAS_NOISE] = {
+        "kalman_meas_noise", "Sensor noise std dev (C)", PARAM_TYPE(PARAM_KALMAN_MEAS_NOISE),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {0.05, 0.001, 5.0, 0.01, 0.05}
+    },
+
+    [PARAM_KALMAN_PROC_NOISE] = {
+        "kalman_proc_noise", "Process noise (C/sqrt(s))", PARAM_TYPE(PARAM_KALMAN_PROC_NOISE),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {0.01, 0.0001, 1.0, 0.001, 0.01}
+    },
+
+    [PARAM_PID_PREDICT_HORIZON] = {
+        "pid_predict_horizon", "Prediction horizon (s, 0=off)", PARAM_TYPE(PARAM_PID_PREDICT_HORIZON),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {30.0, 0.0, 600.0, 5.0, 30.0}
+    },
+
+    [PARAM_EST_TEMP] = {
+        "est_temp", "Estimated temperature", PARAM_TYPE(PARAM_EST_TEMP),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, -55.0, 125.0, 0.1, 0.0}
+    },
+
+    [PARAM_EST_RATE] = {
+        "est_rate", "Estimated dT/dt (C/min)", PARAM_TYPE(PARAM_EST_RATE),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | STREAM_ACCESS | NO_FLASH_SAVE,
+        {0.0, -100.0, 100.0, 0.01, 0.0}
+    },
+
+    [PARAM_EST_LOSS] = {
+        "est_loss", "Estimated ambient loss (C/min)", PARAM_TYPE(PARAM_EST_LOSS),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, -100.0, 100.0, 0.01, 0.0}
+    },
+
+    // Adaptive sensor sampling
+    [PARAM_SAMPLE_ADAPTIVE] = {
+        "sample_adaptive", "Adaptive sensor sampling", PARAM_TYPE(PARAM_SAMPLE_ADAPTIVE),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.boolean = {false, false}}
+    },
+
+    [PARAM_SAMPLE_MIN_INTERVAL] = {
+        "sample_min_interval", "Fastest sample interval (ms)", PARAM_TYPE(PARAM_SAMPLE_MIN_INTERVAL),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {1000.0, 100.0, 10000.0, 100.0, 1000.0}
+    },
+
+    [PARAM_SAMPLE_MAX_INTERVAL] = {
+        "sample_max_interval", "Slowest sample interval (ms)", PARAM_TYPE(PARAM_SAMPLE_MAX_INTERVAL),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {30000.0, 1000.0, 300000.0, 1000.0, 30000.0}
+    },
+
+    [PARAM_SAMPLE_RATE_THRESHOLD] = {
+        "sample_rate_threshold", "Fast sampling above |dT/dt| (C/min)", PARAM_TYPE(PARAM_SAMPLE_RATE_THRESHOLD),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {0.05, 0.0, 10.0, 0.01, 0.05}
+    },
+
+    [PARAM_SAMPLES_PER_HOUR] = {
+        "samples_per_hour", "Effective sensor samples per hour", PARAM_TYPE(PARAM_SAMPLES_PER_HOUR),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE,
+        {0.0, 0.0, 36000.0, 1.0, 0.0}
+    },
+
+    // API memory diagnostics
+    [PARAM_ARENA_PEAK] = {
+        "arena_peak", "Request arena high-water mark (bytes)", PARAM_TYPE(PARAM_ARENA_PEAK),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {.uint16 = {0, 0, 65535, 1, 0}}
+    },
+
+    [PARAM_ARENA_OVERFLOWS] = {
+        "arena_overflows", "Request arena heap fallbacks", PARAM_TYPE(PARAM_ARENA_OVERFLOWS),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {.uint16 = {0, 0, 65535, 1, 0}}
+    },
+
+    [PARAM_HEAP_LARGEST_BLOCK] = {
+        "heap_largest_block", "Largest free heap block (KB)", PARAM_TYPE(PARAM_HEAP_LARGEST_BLOCK),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 4096.0, 0.1, 0.0}
+    },
+
+    // Event stream
+    [PARAM_STREAM_INTERVAL] = {
+        "stream_interval", "Min time between stream events (ms)", PARAM_TYPE(PARAM_STREAM_INTERVAL),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.uint16 = {500, 100, 10000, 100, 500}}
+    },
+
+    // API connection reuse
+    [PARAM_API_REQUESTS] = {
+        "api_requests", "API requests since boot", PARAM_TYPE(PARAM_API_REQUESTS),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 4294967295.0, 1.0, 0.0}
+    },
+
+    [PARAM_API_CONNECTIONS] = {
+        "api_connections", "API TLS connections since boot", PARAM_TYPE(PARAM_API_CONNECTIONS),
+        SERIAL_MENU | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 4294967295.0, 1.0, 0.0}
+    },
+
+    // Derived values, evaluated only when read
+    [PARAM_WIFI_RSSI] = {
+        "wifi_rssi", "WiFi signal (dBm, 0 = not connected)", PARAM_TYPE(PARAM_WIFI_RSSI),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {.int16 = {0, -127, 0, 1, 0}}
+    },
+
+    [PARAM_HEAP_FREE] = {
+        "heap_free", "Free heap (KB)", PARAM_TYPE(PARAM_HEAP_FREE),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 4096.0, 0.1, 0.0}
+    },
+
+    [PARAM_TIME_TO_SETPOINT] = {
+        "time_to_setpoint", "Estimated time to setpoint (min, -1 = not approaching)", PARAM_TYPE(PARAM_TIME_TO_SETPOINT),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {-1.0, -1.0, 100000.0, 1.0, -1.0}
+    },
+
+    // Display and loop timing
+    [PARAM_DISPLAY_MAX_FPS] = {
+        "display_max_fps", "Display frame rate cap (fps)", PARAM_TYPE(PARAM_DISPLAY_MAX_FPS),
+        SERIAL_MENU | DISPLAY_ACCESS | ROTARY_ACCESS | API_ACCESS,
+        {.uint8 = {10, 1, 30, 1, 10}}
+    },
+
+    [PARAM_DISPLAY_I2C_BPS] = {
+        "display_i2c_bps", "Display I2C traffic (bytes/s)", PARAM_TYPE(PARAM_DISPLAY_I2C_BPS),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 1000000.0, 1.0, 0.0}
+    },
+
+    [PARAM_LOOP_TIME_US] = {
+        "loop_time_us", "Average loop() pass (us)", PARAM_TYPE(PARAM_LOOP_TIME_US),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 10000000.0, 1.0, 0.0}
+    },
+
+    [PARAM_DISPLAY_RENDER_US] = {
+        "display_render_us", "Last frame render time (us)", PARAM_TYPE(PARAM_DISPLAY_RENDER_US),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 10000000.0, 1.0, 0.0}
+    },
+
+    [PARAM_DISPLAY_FLUSH_US] = {
+        "display_flush_us", "Last frame I2C flush time (us)", PARAM_TYPE(PARAM_DISPLAY_FLUSH_US),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {0.0, 0.0, 10000000.0, 1.0, 0.0}
+    },
+
+    // Wall clock
+    [PARAM_TIME_SYNCED] = {
+        "time_synced", "Wall clock synced via NTP", PARAM_TYPE(PARAM_TIME_SYNCED),
+        SERIAL_MENU | DISPLAY_ACCESS | API_ACCESS | NO_FLASH_SAVE | COMPUTED,
+        {.boolean = {false, false}}
     }
 
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+// Minimal Arduino.h for building the portable modules on the host
+// (see the harnesses in this directory)
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class String;   // Only named in declarations the harnesses do not call
+
+// Serial goes to stdout
+struct HostSerial {
+    int printf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        int n = vprintf(format, args);
+        va_end(args);
+        return n;
+    }
+    void println(const char* text) { puts(text); }
+};
+
+inline HostSerial Serial;
+
+#endif
@@ -0,0 +1,18 @@
+// Host stand-in for the cJSON allocator interface. The harness provides
+// cJSON_InitHooks and allocates through the installed hooks the way
+// cJSON does (cJSON_malloc/cJSON_free).
+#ifndef HOST_CJSON_H
+#define HOST_CJSON_H
+
+#include <stddef.h>
+
+typedef struct cJSON_Hooks {
+    void* (*malloc_fn)(size_t size);
+    void (*free_fn)(void* ptr);
+} cJSON_Hooks;
+
+void cJSON_InitHooks(cJSON_Hooks* hooks);
+void* cJSON_malloc(size_t size);
+void cJSON_free(void* ptr);
+
+#endif
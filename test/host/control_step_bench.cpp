@@ -0,0 +1,127 @@
+// Host benchmark for the control step (Fixed_point.h, computeAutoPower()
+// in the sketch): one probe reading through the EMA stage and the auto
+// power law, in float, double and the firmware's 1/128 °C fixed point.
+//
+//   g++ -std=c++17 -O2 -Wall -I . -I test/host test/host/control_step_bench.cpp -o /tmp/control_step_bench
+//   /tmp/control_step_bench [steps]
+//
+// The float and double steps are the pre-fixed-point code path (probe
+// read as °C, float EMA, float scaling); the fixed step mirrors
+// TempFilter::ema() and computeAutoPower(). All three run the same
+// random-walk trace and must pick the same power level within 1 %,
+// except where rounding moves a reading across a branch threshold
+// (allowed in under 1 % of the steps).
+// Host CPUs have hardware float and double, the ESP32-C3 has neither,
+// so the ratios printed here understate the gap on the device.
+
+#include "Fixed_point.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Control params as the firmware holds them (floats in the param table)
+struct Limits {
+  float setpoint = 20.0f;
+  float switchingDelta = 2.0f;
+  float maxTempDiff = 1.0f;
+  float minTempDiff = 0.05f;
+  float maxPower = 100.0f;
+  float minPower = 5.0f;
+  float alpha = 0.2f;
+};
+
+static const Limits limits;
+
+template <typename T>
+struct FloatStep {
+  T ema = 0;
+  bool seeded = false;
+
+  uint8_t step(int32_t raw) {
+    T temp = (T)raw / TEMP_FX_ONE;   // DallasTemperature::rawToCelsius()
+    ema = seeded ? ema + (T)limits.alpha * (temp - ema) : temp;
+    seeded = true;
+
+    T error = (T)limits.setpoint - ema;
+    if (fabs(error) > (T)limits.switchingDelta) {
+      return error > 0 ? (uint8_t)limits.maxPower : 0;
+    }
+    if (error >= (T)limits.maxTempDiff) return (uint8_t)limits.maxPower;
+    if (error <= (T)limits.minTempDiff) return (uint8_t)limits.minPower;
+    T scale = (error - (T)limits.minTempDiff) / ((T)limits.maxTempDiff - (T)limits.minTempDiff);
+    return (uint8_t)((T)limits.minPower + ((T)limits.maxPower - (T)limits.minPower) * scale);
+  }
+};
+
+struct FixedStep {
+  int32_t emaState = 0;
+  bool seeded = false;
+
+  uint8_t step(int32_t raw) {
+    // TempFilter::ema(), alpha converted only when the param changes
+    int32_t alphaQ8 = (int32_t)lroundf(limits.alpha * 256);
+    int32_t target = raw << 8;
+    emaState = seeded ? emaState + (int32_t)(((int64_t)alphaQ8 * (target - emaState)) >> 8) : target;
+    seeded = true;
+
+    // computeAutoPower(), limits converted once per tick
+    temp_fx_t error = tempFxFromFloat(limits.setpoint) - (emaState >> 8);
+    int32_t maxPower = (int32_t)limits.maxPower;
+    int32_t minPower = (int32_t)limits.minPower;
+    if (abs(error) > tempFxFromFloat(limits.switchingDelta)) {
+      return error > 0 ? maxPower : 0;
+    }
+    temp_fx_t maxTempDiff = tempFxFromFloat(limits.maxTempDiff);
+    temp_fx_t minTempDiff = tempFxFromFloat(limits.minTempDiff);
+    if (error >= maxTempDiff) return maxPower;
+    if (error <= minTempDiff) return minPower;
+    return minPower + (maxPower - minPower) * (error - minTempDiff) / (maxTempDiff - minTempDiff);
+  }
+};
+
+// Probe trace around the setpoint, in DS18B20 1/16 °C steps
+static std::vector<int32_t> makeTrace(size_t steps) {
+  std::mt19937 rng(2929);
+  std::vector<int32_t> trace(steps);
+  int32_t sixteenths = 17 * 16;
+  for (size_t i = 0; i < steps; i++) {
+    sixteenths += (int32_t)(rng() % 5) - 2;
+    if (sixteenths < 15 * 16) sixteenths = 15 * 16;
+    if (sixteenths > 25 * 16) sixteenths = 25 * 16;
+    trace[i] = sixteenths << 3;
+  }
+  return trace;
+}
+
+template <typename Step>
+static double timeSteps(const std::vector<int32_t>& trace, std::vector<uint8_t>& out) {
+  Step controller;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < trace.size(); i++) out[i] = controller.step(trace[i]);
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return elapsed * 1e9 / trace.size();
+}
+
+int main(int argc, char** argv) {
+  size_t steps = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+  std::vector<int32_t> trace = makeTrace(steps);
+  std::vector<uint8_t> floatOut(steps), doubleOut(steps), fixedOut(steps);
+
+  double floatNs = timeSteps<FloatStep<float>>(trace, floatOut);
+  double doubleNs = timeSteps<FloatStep<double>>(trace, doubleOut);
+  double fixedNs = timeSteps<FixedStep>(trace, fixedOut);
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < steps; i++) {
+    if (abs(fixedOut[i] - floatOut[i]) > 1 || abs(fixedOut[i] - doubleOut[i]) > 1) mismatches++;
+  }
+
+  printf("%zu steps\n", steps);
+  printf("float:  %6.2f ns/step\n", floatNs);
+  printf("double: %6.2f ns/step (%.2fx float)\n", doubleNs, doubleNs / floatNs);
+  printf("fixed:  %6.2f ns/step (%.2fx float)\n", fixedNs, fixedNs / floatNs);
+  printf("power level differs by more than 1 %% in %zu steps (%.3f%%)\n",
+         mismatches, 100.0 * mismatches / steps);
+  return mismatches * 100 > steps ? 1 : 0;
+}
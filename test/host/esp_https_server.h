@@ -0,0 +1,16 @@
+// Host stand-in for the esp_https_server calls made by the portable
+// modules. The harness defines httpd_resp_send_chunk() as its sink.
+#ifndef HOST_ESP_HTTPS_SERVER_H
+#define HOST_ESP_HTTPS_SERVER_H
+
+#include <sys/types.h>
+
+typedef int esp_err_t;
+#define ESP_OK    0
+#define ESP_FAIL  -1
+
+typedef struct httpd_req httpd_req_t;
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t* req, const char* buf, ssize_t len);
+
+#endif
@@ -0,0 +1,22 @@
+// Host stand-in for the FreeRTOS types used by the portable modules
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+typedef void* TaskHandle_t;
+
+// Critical sections as a spinlock; the device variant also masks interrupts
+typedef struct {
+    volatile int owner;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+
+inline void portENTER_CRITICAL(portMUX_TYPE* mux) {
+    while (__atomic_exchange_n(&mux->owner, 1, __ATOMIC_ACQUIRE)) {}
+}
+
+inline void portEXIT_CRITICAL(portMUX_TYPE* mux) {
+    __atomic_store_n(&mux->owner, 0, __ATOMIC_RELEASE);
+}
+
+#endif
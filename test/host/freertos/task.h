@@ -0,0 +1,12 @@
+// Host stand-in: each thread plays one FreeRTOS task
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    static thread_local char task;
+    return &task;
+}
+
+#endif
@@ -0,0 +1,179 @@
+// Host comparison of the JSON and CBOR wire formats of the API: payload
+// size, encode time and decode time with the firmware's own writers
+// (Json_Stream.cpp, Cbor_Stream.cpp) and readers (Json_Parser.cpp,
+// CborReader).
+//
+//   g++ -std=c++17 -O2 -Wall -I . -I test/host test/host/json_cbor_compare.cpp Json_Stream.cpp Cbor_Stream.cpp Json_Parser.cpp -o /tmp/json_cbor_compare
+//   /tmp/json_cbor_compare
+//
+// Documents, shaped like the handlers write them:
+//   config - GET /api/config for 89 params: JSON keyed by name with
+//            values formatted as raw text first (formatParam), CBOR keyed
+//            by param index with native values
+//   set    - a five-param POST /api/set body, keys by name in both
+// Decoding walks every pair the way set_handler/set_cbor_handler do and
+// must see the same number of pairs as were encoded.
+
+#include "Json_Stream.h"
+#include "Cbor_Stream.h"
+#include "Json_Parser.h"
+#include <esp_https_server.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Json_Stream.cpp links against the httpd sink; the harness never uses it
+esp_err_t httpd_resp_send_chunk(httpd_req_t*, const char*, ssize_t) {
+  return ESP_FAIL;
+}
+
+enum ParamKind { KIND_FLOAT, KIND_UINT, KIND_BOOL, KIND_STRING };
+
+struct Param {
+  uint32_t index;
+  std::string name;
+  ParamKind kind;
+  float number;
+  unsigned long uint;
+  bool boolean;
+  std::string string;
+};
+
+static std::vector<Param> makeParams(int count, int offset) {
+  static const char* stems[] = { "temp", "pid", "probe", "display", "wifi", "energy", "duty", "api" };
+  std::vector<Param> params;
+  for (int i = offset; i < offset + count; i++) {
+    Param p;
+    p.index = i;
+    p.name = std::string(stems[i % 8]) + "_param_" + std::to_string(i);
+    p.kind = (ParamKind)(i % 4 == 3 && i % 3 ? KIND_STRING : i % 3);
+    p.number = 20.0f + i * 0.125f;
+    p.uint = i * 37;
+    p.boolean = i % 2;
+    p.string = i % 5 ? "28ff641e8216c3a1" : "fermenter-lab";
+    params.push_back(p);
+  }
+  return params;
+}
+
+static bool appendSink(void* ctx, const char* data, size_t len) {
+  ((std::string*)ctx)->append(data, len);
+  return true;
+}
+
+static void encodeJson(const std::vector<Param>& params, std::string& out) {
+  JsonStreamWriter json(appendSink, &out);
+  json.beginObject();
+  for (const Param& p : params) {
+    json.key(p.name.c_str());
+    char text[32];
+    switch (p.kind) {
+      case KIND_FLOAT:
+        snprintf(text, sizeof(text), "%.7g", p.number);
+        json.valueNumber(text);
+        break;
+      case KIND_UINT:
+        snprintf(text, sizeof(text), "%lu", p.uint);
+        json.valueNumber(text);
+        break;
+      case KIND_BOOL:   json.valueBool(p.boolean); break;
+      case KIND_STRING: json.valueString(p.string.c_str()); break;
+    }
+  }
+  json.endObject();
+  json.finish();
+}
+
+static void encodeCbor(const std::vector<Param>& params, bool indexKeys, std::string& out) {
+  CborStreamWriter cbor(appendSink, &out);
+  cbor.beginMap();
+  for (const Param& p : params) {
+    if (indexKeys) {
+      cbor.valueUint(p.index);
+    } else {
+      cbor.valueString(p.name.c_str());
+    }
+    switch (p.kind) {
+      case KIND_FLOAT:  cbor.valueFloat(p.number); break;
+      case KIND_UINT:   cbor.valueUint(p.uint); break;
+      case KIND_BOOL:   cbor.valueBool(p.boolean); break;
+      case KIND_STRING: cbor.valueString(p.string.c_str()); break;
+    }
+  }
+  cbor.end();
+  cbor.finish();
+}
+
+static void countPair(void* ctx, const char*, JsonValueKind, const char*) {
+  (*(size_t*)ctx)++;
+}
+
+static size_t decodeJson(const std::string& doc) {
+  size_t pairs = 0;
+  JsonStreamParser parser(countPair, &pairs);
+  if (!parser.feed(doc.data(), doc.size()) || !parser.finish()) return 0;
+  return pairs;
+}
+
+static size_t decodeCbor(const std::string& doc) {
+  CborReader reader((const uint8_t*)doc.data(), doc.size());
+  CborItem map;
+  if (!reader.next(map) || map.kind != CBOR_ITEM_MAP) return 0;
+  size_t pairs = 0;
+  while (map.indefinite || pairs < map.length) {
+    CborItem key, value;
+    if (!reader.next(key)) return 0;
+    if (key.kind == CBOR_ITEM_BREAK && map.indefinite) break;
+    if (!reader.skip(key) || !reader.next(value) || value.kind == CBOR_ITEM_BREAK) return 0;
+    if (!reader.skip(value)) return 0;
+    pairs++;
+  }
+  return pairs;
+}
+
+// Runs fn for about a quarter second and returns ns per call
+template <typename Fn>
+static double timeIt(Fn fn) {
+  unsigned long calls = 0;
+  auto start = std::chrono::steady_clock::now();
+  double elapsed;
+  do {
+    for (int i = 0; i < 100; i++) fn();
+    calls += 100;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < 0.25);
+  return elapsed * 1e9 / calls;
+}
+
+static int failures = 0;
+
+static void compare(const char* name, const std::vector<Param>& params, bool cborIndexKeys) {
+  std::string json, cbor;
+  encodeJson(params, json);
+  encodeCbor(params, cborIndexKeys, cbor);
+
+  if (decodeJson(json) != params.size() || decodeCbor(cbor) != params.size()) {
+    printf("FAIL: %s does not decode to %zu pairs\n", name, params.size());
+    failures++;
+    return;
+  }
+
+  double jsonEncode = timeIt([&] { std::string out; out.reserve(json.size()); encodeJson(params, out); });
+  double cborEncode = timeIt([&] { std::string out; out.reserve(cbor.size()); encodeCbor(params, cborIndexKeys, out); });
+  size_t sink = 0;
+  double jsonDecode = timeIt([&] { sink += decodeJson(json); });
+  double cborDecode = timeIt([&] { sink += decodeCbor(cbor); });
+
+  printf("%-7s %2zu params  JSON %5zu B  encode %7.0f ns  decode %7.0f ns\n",
+         name, params.size(), json.size(), jsonEncode, jsonDecode);
+  printf("                   CBOR %5zu B  encode %7.0f ns  decode %7.0f ns  (%.0f%% of JSON size)\n",
+         cbor.size(), cborEncode, cborDecode, 100.0 * cbor.size() / json.size());
+  if (!sink) failures++;
+}
+
+int main() {
+  compare("config", makeParams(89, 0), true);
+  compare("set", makeParams(5, 20), false);
+  return failures ? 1 : 0;
+}
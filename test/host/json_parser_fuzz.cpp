@@ -0,0 +1,241 @@
+// Host fuzz and throughput harness for JsonStreamParser (Json_Parser.cpp).
+//
+//   g++ -std=c++17 -O2 -g -Wall -fsanitize=address,undefined -I . -I test/host test/host/json_parser_fuzz.cpp Json_Parser.cpp -o /tmp/json_parser_fuzz
+//   /tmp/json_parser_fuzz [fuzz-iterations]
+//
+// Checks, in order:
+//   - conformance vectors (RFC 8259 numbers, true/false/null only)
+//   - every valid vector gives the same result when split at every offset
+//   - random mutations of the seeds: no crash/sanitizer report, chunked
+//     feeding matches one-shot feeding, and every NUMBER passes an
+//     independent grammar check
+//   - throughput on a /api/set sized body
+// Exits non-zero if any check fails.
+
+#include "Json_Parser.h"
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Result {
+  bool ok;
+  std::string error;
+  size_t offset;
+  std::vector<std::string> pairs;   // "key|kind|text"
+
+  bool operator==(const Result& o) const {
+    return ok == o.ok && error == o.error && offset == o.offset && pairs == o.pairs;
+  }
+};
+
+static void collect(void* ctx, const char* key, JsonValueKind kind, const char* text) {
+  static const char* kinds[] = { "string", "number", "bool", "null", "nested", "oversize" };
+  std::string pair = key;
+  pair += '|';
+  pair += kinds[kind];
+  pair += '|';
+  pair += text;
+  ((Result*)ctx)->pairs.push_back(pair);
+}
+
+// Feeds doc in chunks of the given sizes (cycled); empty = one shot
+static Result parse(const std::string& doc, const std::vector<size_t>& chunks = {}) {
+  Result result;
+  JsonStreamParser parser(collect, &result);
+  bool ok = true;
+  size_t pos = 0, chunk = 0;
+  while (ok && pos < doc.size()) {
+    size_t len = chunks.empty() ? doc.size() : chunks[chunk++ % chunks.size()];
+    if (len > doc.size() - pos) len = doc.size() - pos;
+    ok = parser.feed(doc.data() + pos, len);
+    pos += len;
+  }
+  if (ok) ok = parser.finish();
+  result.ok = ok;
+  result.error = parser.getError() ? parser.getError() : "";
+  result.offset = ok ? 0 : parser.getErrorOffset();
+  return result;
+}
+
+static int failures = 0;
+
+static void check(bool condition, const char* what, const std::string& doc) {
+  if (condition) return;
+  printf("FAIL: %s\n  input: %s\n", what, doc.c_str());
+  failures++;
+}
+
+struct Vector {
+  const char* doc;
+  bool ok;
+  const char* firstPair;   // Expected first pair when ok (nullptr = none)
+};
+
+static const Vector vectors[] = {
+  // Numbers
+  { "{\"a\":0}", true, "a|number|0" },
+  { "{\"a\":-0}", true, "a|number|-0" },
+  { "{\"a\":12.5}", true, "a|number|12.5" },
+  { "{\"a\":-1e10}", true, "a|number|-1e10" },
+  { "{\"a\":1E+2}", true, "a|number|1E+2" },
+  { "{\"a\":0.5e-3}", true, "a|number|0.5e-3" },
+  { "{\"a\" : 7 }", true, "a|number|7" },
+  { "{\"a\":01}", false, nullptr },
+  { "{\"a\":-}", false, nullptr },
+  { "{\"a\":1.}", false, nullptr },
+  { "{\"a\":.5}", false, nullptr },
+  { "{\"a\":1e}", false, nullptr },
+  { "{\"a\":1e+}", false, nullptr },
+  { "{\"a\":+1}", false, nullptr },
+  { "{\"a\":0x10}", false, nullptr },
+  { "{\"a\":1.5.2}", false, nullptr },
+  { "{\"a\":--1}", false, nullptr },
+  { "{\"a\":-inf}", false, nullptr },
+  // Literals
+  { "{\"a\":true}", true, "a|bool|true" },
+  { "{\"a\":false}", true, "a|bool|false" },
+  { "{\"a\":null}", true, "a|null|null" },
+  { "{\"a\":nan}", false, nullptr },
+  { "{\"a\":inf}", false, nullptr },
+  { "{\"a\":infinity}", false, nullptr },
+  { "{\"a\":tru}", false, nullptr },
+  { "{\"a\":truex}", false, nullptr },
+  { "{\"a\":True}", false, nullptr },
+  { "{\"a\":nulll}", false, nullptr },
+  { "{\"a\":t1}", false, nullptr },
+  // Strings and structure
+  { "{\"a\":\"x\\u00e9\\n\"}", true, "a|string|x\xc3\xa9\n" },
+  { "{\"a\":[1,{\"b\":\"]\"}],\"c\":1}", true, "a|nested|" },
+  { "{}", true, nullptr },
+  { " { } ", true, nullptr },
+  { "{\"a\":1,}", false, nullptr },
+  { "{\"a\":1 \"b\":2}", false, nullptr },
+  { "{\"a\":1}x", false, nullptr },
+  { "{\"a\":\"\\q\"}", false, nullptr },
+  { "{\"a\":\"\x01\"}", false, nullptr },
+  { "{\"a\":1", false, nullptr },
+  { "[1]", false, nullptr },
+};
+
+static void conformance() {
+  for (const Vector& v : vectors) {
+    std::string doc = v.doc;
+    Result whole = parse(doc);
+    check(whole.ok == v.ok, v.ok ? "expected accept" : "expected reject", doc);
+    if (v.ok && v.firstPair) {
+      check(!whole.pairs.empty() && whole.pairs[0] == v.firstPair, "first pair mismatch", doc);
+    }
+    // Every split point must give the same result
+    for (size_t split = 1; split < doc.size(); split++) {
+      check(parse(doc, { split, doc.size() }) == whole, "split result differs", doc);
+    }
+    check(parse(doc, { 1 }) == whole, "byte-at-a-time result differs", doc);
+  }
+}
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?, written out rather than
+// via std::regex (whose libstdc++ headers warn under -Wall -O2)
+static bool matchesNumberGrammar(const std::string& text) {
+  const char* p = text.c_str();
+  auto digits = [&p] {
+    const char* start = p;
+    while (*p >= '0' && *p <= '9') p++;
+    return p > start;
+  };
+  if (*p == '-') p++;
+  if (*p == '0') {
+    p++;
+  } else if (*p < '1' || *p > '9' || !digits()) {
+    return false;
+  }
+  if (*p == '.') {
+    p++;
+    if (!digits()) return false;
+  }
+  if (*p == 'e' || *p == 'E') {
+    p++;
+    if (*p == '+' || *p == '-') p++;
+    if (!digits()) return false;
+  }
+  return *p == '\0';
+}
+
+static void fuzz(unsigned long iterations) {
+  static const char alphabet[] = "{}[]\":,\\ -+.eE0123456789tfnulrasxq\x01\xc3";
+  std::mt19937 rng(12345);
+  std::vector<std::string> seeds;
+  for (const Vector& v : vectors) seeds.push_back(v.doc);
+  seeds.push_back("{\"temp_setpoint\":20.5,\"heater_enabled\":true,\"wifi_ssid\":\"lab\",\"kp\":-1.25e2}");
+
+  for (unsigned long i = 0; i < iterations; i++) {
+    std::string doc = seeds[rng() % seeds.size()];
+    int mutations = 1 + rng() % 4;
+    for (int m = 0; m < mutations; m++) {
+      size_t pos = doc.empty() ? 0 : rng() % (doc.size() + 1);
+      char c = alphabet[rng() % (sizeof(alphabet) - 1)];
+      switch (rng() % 3) {
+        case 0: doc.insert(pos, 1, c); break;
+        case 1: if (pos < doc.size()) doc.erase(pos, 1); break;
+        default: if (pos < doc.size()) doc[pos] = c; break;
+      }
+    }
+    if (rng() % 16 == 0) doc += std::string(80 + rng() % 40, '7');   // Oversize value/tail
+
+    Result whole = parse(doc);
+    std::vector<size_t> chunks;
+    for (int c = 0; c < 4; c++) chunks.push_back(1 + rng() % 8);
+    check(parse(doc, chunks) == whole, "chunked result differs", doc);
+
+    for (const std::string& pair : whole.pairs) {
+      size_t bar = pair.rfind('|');
+      if (pair.compare(pair.find('|'), 8, "|number|") != 0) continue;
+      std::string text = pair.substr(bar + 1);
+      check(matchesNumberGrammar(text), "number outside RFC 8259 grammar", doc);
+    }
+    if (failures > 20) return;
+  }
+}
+
+static void throughput() {
+  std::string body = "{";
+  for (int i = 0; i < 40; i++) {
+    char pair[96];
+    snprintf(pair, sizeof(pair), "%s\"param_%02d\": %s", i ? ", " : "", i,
+             i % 3 == 0 ? "-12.375e-1" : (i % 3 == 1 ? "\"some text \\u00e9\"" : "true"));
+    body += pair;
+  }
+  body += "}";
+
+  size_t pairs = 0;
+  unsigned long rounds = 0;
+  auto start = std::chrono::steady_clock::now();
+  double elapsed;
+  do {
+    for (int r = 0; r < 1000; r++) {
+      Result result;
+      JsonStreamParser parser(collect, &result);
+      parser.feed(body.data(), body.size());
+      parser.finish();
+      pairs += result.pairs.size();
+    }
+    rounds += 1000;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < 1.0);
+
+  printf("throughput: %zu-byte body, %.1f MB/s, %.0f pairs/s (incl. harness callback)\n",
+         body.size(), rounds * body.size() / elapsed / 1e6, pairs / elapsed);
+}
+
+int main(int argc, char** argv) {
+  unsigned long iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+
+  conformance();
+  printf("conformance: %zu vectors, %d failures\n", sizeof(vectors) / sizeof(vectors[0]), failures);
+  fuzz(iterations);
+  printf("fuzz: %lu iterations, %d failures\n", iterations, failures);
+  if (failures) return 1;
+  throughput();
+  return 0;
+}
@@ -0,0 +1,221 @@
+// Host comparison of a cJSON tree against JsonStreamWriter (Json_Stream.cpp)
+// for a /api/config sized response: peak heap on the model device heap
+// and response latency.
+//
+//   g++ -std=c++17 -O2 -Wall -I . -I test/host -Wl,--wrap=malloc,--wrap=free test/host/json_stream_heap.cpp Json_Stream.cpp -o /tmp/json_stream_heap
+//   /tmp/json_stream_heap [responses]
+//
+// The tree path is the pre-streaming handler: cJSON_CreateObject(), one
+// node per param (40 B on the ESP32) plus the key and string value
+// copies, cJSON_PrintUnformatted() growing its print buffer by doubling,
+// one send, then free. The streaming path is config_get_handler()'s
+// JsonStreamWriter sending chunks of JSON_STREAM_BUFFER_SIZE. Both write
+// the same document to the same sink; the harness checks the bytes match.
+//
+// Reported per path: peak model-heap use during the response (block
+// sizes incl. headers; the writer itself lives on the handler's stack and
+// is listed separately), time to the first byte handed to httpd and time
+// to the last. Fails if the streaming path touches the heap or the two
+// documents differ.
+
+#include "Json_Stream.h"
+#include <esp_https_server.h>
+#include "model_heap.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define CJSON_NODE_SIZE  40   // sizeof(cJSON) on the ESP32
+#define CJSON_PRINT_INITIAL  256
+
+// Synthetic /api/config: names and value mix of the param table
+
+enum ParamKind { KIND_FLOAT, KIND_UINT, KIND_BOOL, KIND_STRING };
+
+struct Param {
+  std::string name;
+  ParamKind kind;
+  float number;
+  unsigned long uint;
+  bool boolean;
+  std::string string;
+};
+
+static std::vector<Param> makeParams() {
+  static const char* stems[] = { "temp", "pid", "probe", "display", "wifi", "energy", "duty", "api" };
+  std::vector<Param> params;
+  for (int i = 0; i < 89; i++) {
+    Param p;
+    p.name = std::string(stems[i % 8]) + "_param_" + std::to_string(i);
+    p.kind = (ParamKind)(i % 4 == 3 && i % 3 ? KIND_STRING : i % 3);
+    p.number = 20.0f + i * 0.125f;
+    p.uint = i * 37;
+    p.boolean = i % 2;
+    p.string = i % 5 ? "28ff641e8216c3a1" : "fermenter-lab";
+    params.push_back(p);
+  }
+  return params;
+}
+
+// Sink: records the first and last send and the bytes sent
+
+struct Sink {
+  std::chrono::steady_clock::time_point start, first, last;
+  bool started;
+  std::string body;
+};
+
+static Sink sink;
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t*, const char* buf, ssize_t len) {
+  auto now = std::chrono::steady_clock::now();
+  if (!sink.started) sink.first = now;
+  sink.started = true;
+  sink.last = now;
+  if (buf && len > 0) sink.body.append(buf, len);
+  return ESP_OK;
+}
+
+static void sinkReset() {
+  sink.started = false;
+  sink.body.clear();
+  sink.start = std::chrono::steady_clock::now();
+}
+
+// cJSON model: allocation pattern of cJSON 1.7 with the default hooks
+
+struct PrintBuffer {
+  char* buffer;
+  size_t length;
+  size_t offset;
+};
+
+static char* modelStrdup(const char* str) {
+  size_t len = strlen(str) + 1;
+  char* copy = (char*)malloc(len);
+  if (copy) memcpy(copy, str, len);
+  return copy;
+}
+
+static void append(PrintBuffer& p, const char* data, size_t len) {
+  size_t needed = p.offset + len + 1;
+  if (needed > p.length) {
+    size_t newSize = needed * 2;   // cJSON ensure(); realloc moves the block
+    char* bigger = (char*)malloc(newSize);
+    memcpy(bigger, p.buffer, p.offset);
+    free(p.buffer);
+    p.buffer = bigger;
+    p.length = newSize;
+  }
+  memcpy(p.buffer + p.offset, data, len);
+  p.offset += len;
+  p.buffer[p.offset] = '\0';
+}
+
+static void appendString(PrintBuffer& p, const char* str) {
+  append(p, "\"", 1);
+  append(p, str, strlen(str));
+  append(p, "\"", 1);
+}
+
+static void treeResponse(const std::vector<Param>& params) {
+  std::vector<void*> blocks;
+  std::vector<const char*> keys, strings;
+  blocks.push_back(malloc(CJSON_NODE_SIZE));   // root
+  for (const Param& p : params) {
+    blocks.push_back(malloc(CJSON_NODE_SIZE));
+    keys.push_back(modelStrdup(p.name.c_str()));
+    strings.push_back(p.kind == KIND_STRING ? modelStrdup(p.string.c_str()) : nullptr);
+  }
+
+  PrintBuffer out = { (char*)malloc(CJSON_PRINT_INITIAL), CJSON_PRINT_INITIAL, 0 };
+  append(out, "{", 1);
+  for (size_t i = 0; i < params.size(); i++) {
+    const Param& p = params[i];
+    if (i) append(out, ",", 1);
+    appendString(out, keys[i]);
+    append(out, ":", 1);
+    char num[26];
+    int n;
+    switch (p.kind) {
+      case KIND_FLOAT:  n = snprintf(num, sizeof(num), "%.7g", p.number); append(out, num, n); break;
+      case KIND_UINT:   n = snprintf(num, sizeof(num), "%lu", p.uint); append(out, num, n); break;
+      case KIND_BOOL:   append(out, p.boolean ? "true" : "false", p.boolean ? 4 : 5); break;
+      case KIND_STRING: appendString(out, strings[i]); break;
+    }
+  }
+  append(out, "}", 1);
+
+  httpd_resp_send_chunk(nullptr, out.buffer, out.offset);   // httpd_resp_sendstr()
+  free(out.buffer);
+  for (size_t i = 0; i < keys.size(); i++) {
+    free((void*)keys[i]);
+    free((void*)strings[i]);
+  }
+  for (void* block : blocks) free(block);
+}
+
+static void streamResponse(const std::vector<Param>& params) {
+  JsonStreamWriter json(JsonStreamWriter::httpdChunkFlush, nullptr);
+  json.beginObject();
+  for (const Param& p : params) {
+    json.key(p.name.c_str());
+    switch (p.kind) {
+      case KIND_FLOAT:  json.valueFloat(p.number); break;
+      case KIND_UINT:   json.valueUint(p.uint); break;
+      case KIND_BOOL:   json.valueBool(p.boolean); break;
+      case KIND_STRING: json.valueString(p.string.c_str()); break;
+    }
+  }
+  json.endObject();
+  json.finish();
+}
+
+struct Report {
+  size_t peak;
+  double firstUs;
+  double lastUs;
+  std::string body;
+};
+
+static Report measure(void (*respond)(const std::vector<Param>&),
+                      const std::vector<Param>& params, unsigned long responses) {
+  Report report = { 0, 0.0, 0.0, "" };
+  for (unsigned long r = 0; r < responses; r++) {
+    heapPeakReset();
+    size_t base = heapUsed;
+    sinkReset();
+    respond(params);
+    report.peak = std::max(report.peak, heapPeak - base);
+    report.firstUs += std::chrono::duration<double, std::micro>(sink.first - sink.start).count();
+    report.lastUs += std::chrono::duration<double, std::micro>(sink.last - sink.start).count();
+  }
+  report.firstUs /= responses;
+  report.lastUs /= responses;
+  report.body = sink.body;
+  return report;
+}
+
+int main(int argc, char** argv) {
+  unsigned long responses = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+  std::vector<Param> params = makeParams();
+  heapReset();
+
+  Report tree = measure(treeResponse, params, responses);
+  Report stream = measure(streamResponse, params, responses);
+
+  printf("%zu params, %zu-byte document, %lu responses\n", params.size(), tree.body.size(), responses);
+  printf("cJSON tree: peak heap %6zu B, first byte %7.2f us, last byte %7.2f us\n",
+         tree.peak, tree.firstUs, tree.lastUs);
+  printf("streaming:  peak heap %6zu B (+%zu B writer on the stack), first byte %7.2f us, last byte %7.2f us\n",
+         stream.peak, sizeof(JsonStreamWriter), stream.firstUs, stream.lastUs);
+
+  if (failedAllocs || stream.peak != 0 || stream.body != tree.body) {
+    printf("FAIL%s%s%s\n", failedAllocs ? ": model heap exhausted" : "",
+           stream.peak ? ": streaming allocated" : "",
+           stream.body != tree.body ? ": documents differ" : "");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,132 @@
+// Model of the ESP32 heap shared by the host harnesses: a 64 KB
+// first-fit heap with boundary-tag coalescing. Link the harness with
+//   -Wl,--wrap=malloc,--wrap=free
+// so malloc/free from the modules under test land here (the harness'
+// own containers use operator new and stay on the host heap). Include
+// from exactly one translation unit.
+#ifndef HOST_MODEL_HEAP_H
+#define HOST_MODEL_HEAP_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <mutex>
+
+#define MODEL_HEAP_SIZE  (64 * 1024)
+#define MODEL_ALIGN      8
+
+struct Block {
+  uint32_t size;      // Whole block incl. header and footer
+  uint32_t used;
+  Block* prev;        // Free list links (free blocks only)
+  Block* next;
+};
+
+#define BLOCK_OVERHEAD  (sizeof(Block) + MODEL_ALIGN)   // Header + footer
+
+alignas(MODEL_ALIGN) static uint8_t heap[MODEL_HEAP_SIZE];
+static Block* freeList = nullptr;
+static std::mutex heapLock;
+static unsigned long failedAllocs = 0;
+static size_t heapUsed = 0;       // Block bytes in use, headers included
+static size_t heapPeak = 0;
+
+static inline uint32_t& footer(Block* b) {
+  return *(uint32_t*)((uint8_t*)b + b->size - MODEL_ALIGN);
+}
+
+static inline void setSize(Block* b, uint32_t size) {
+  b->size = size;
+  footer(b) = size;
+}
+
+static inline void unlink(Block* b) {
+  if (b->prev) b->prev->next = b->next; else freeList = b->next;
+  if (b->next) b->next->prev = b->prev;
+}
+
+static inline void push(Block* b) {
+  b->used = 0;
+  b->prev = nullptr;
+  b->next = freeList;
+  if (freeList) freeList->prev = b;
+  freeList = b;
+}
+
+static inline void heapReset() {
+  Block* b = (Block*)heap;
+  setSize(b, MODEL_HEAP_SIZE);
+  freeList = nullptr;
+  push(b);
+  failedAllocs = 0;
+  heapUsed = heapPeak = 0;
+}
+
+static inline bool inHeap(const void* p) {
+  return (const uint8_t*)p >= heap && (const uint8_t*)p < heap + MODEL_HEAP_SIZE;
+}
+
+extern "C" void* __real_malloc(size_t size);
+extern "C" void __real_free(void* ptr);
+
+extern "C" void* __wrap_malloc(size_t size) {
+  std::lock_guard<std::mutex> guard(heapLock);
+  uint32_t need = (size + BLOCK_OVERHEAD + MODEL_ALIGN - 1) & ~(uint32_t)(MODEL_ALIGN - 1);
+  for (Block* b = freeList; b; b = b->next) {
+    if (b->size < need) continue;
+    unlink(b);
+    if (b->size - need >= BLOCK_OVERHEAD + MODEL_ALIGN) {
+      Block* rest = (Block*)((uint8_t*)b + need);
+      setSize(rest, b->size - need);
+      push(rest);
+      setSize(b, need);
+    }
+    b->used = 1;
+    heapUsed += b->size;
+    if (heapUsed > heapPeak) heapPeak = heapUsed;
+    return (uint8_t*)b + sizeof(Block);
+  }
+  failedAllocs++;
+  return nullptr;
+}
+
+extern "C" void __wrap_free(void* ptr) {
+  if (!ptr) return;
+  if (!inHeap(ptr)) { __real_free(ptr); return; }
+  std::lock_guard<std::mutex> guard(heapLock);
+  Block* b = (Block*)((uint8_t*)ptr - sizeof(Block));
+  heapUsed -= b->size;
+
+  Block* next = (Block*)((uint8_t*)b + b->size);
+  if ((uint8_t*)next < heap + MODEL_HEAP_SIZE && !next->used) {
+    unlink(next);
+    setSize(b, b->size + next->size);
+  }
+  if ((uint8_t*)b > heap) {
+    uint32_t prevSize = *(uint32_t*)((uint8_t*)b - MODEL_ALIGN);
+    Block* prev = (Block*)((uint8_t*)b - prevSize);
+    if (!prev->used) {
+      unlink(prev);
+      setSize(prev, prev->size + b->size);
+      b = prev;
+    }
+  }
+  push(b);
+}
+
+static inline void heapStats(size_t& freeBytes, size_t& largest) {
+  std::lock_guard<std::mutex> guard(heapLock);
+  freeBytes = largest = 0;
+  for (Block* b = freeList; b; b = b->next) {
+    size_t usable = b->size - BLOCK_OVERHEAD;
+    freeBytes += usable;
+    if (usable > largest) largest = usable;
+  }
+}
+
+// Highest heapUsed since the last heapPeakReset()
+static inline void heapPeakReset() {
+  std::lock_guard<std::mutex> guard(heapLock);
+  heapPeak = heapUsed;
+}
+
+#endif
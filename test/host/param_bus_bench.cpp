@@ -0,0 +1,175 @@
+// Host benchmark for ParamBus::dispatch() (Param_bus.cpp) with every
+// subscriber slot taken, on the firmware's param table (param_config.cpp).
+//
+//   g++ -std=c++17 -O2 -Wall -I . -I test/host test/host/param_bus_bench.cpp Param_bus.cpp param_config.cpp -o /tmp/param_bus_bench
+//   /tmp/param_bus_bench [rounds]
+//
+// PARAM_BUS_MAX_SUBSCRIBERS subscribers: the two the firmware registers
+// (the display by DISPLAY_ACCESS, the dimmer by PARAM_POWER_LEVEL) plus
+// flag subscribers for the other front ends; one more must be refused.
+// Each round changes params the way markParamChanged() does and then
+// dispatches once:
+//   queued     - 8 distinct params, delivered from the ring
+//   superseded - one param changed 8 times, delivered once
+//   overflow   - more changes than the ring holds, delivered by the
+//                rescan of the change generations
+// Before timing, each scenario must deliver every changed param exactly
+// once, with its latest generation, to every matching subscriber and to
+// no one else; the harness exits non-zero otherwise.
+
+#include "Param_bus.h"
+#include "Param_helpers.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Change tracking as in Param_helpers.cpp
+static uint32_t generation = 0;
+static uint32_t changedGen[PARAM_COUNT];
+
+uint32_t getParamChangedGen(ParamIndex index) {
+    return changedGen[index];
+}
+
+static void change(ParamIndex index) {
+    changedGen[index] = ++generation;
+    paramBus.publish(index, generation);
+}
+
+// Subscribers
+
+struct Sub {
+    int16_t index;       // -1 = by flags
+    uint16_t flagMask;
+};
+
+static const Sub subs[] = {
+    { -1, DISPLAY_ACCESS },
+    { PARAM_POWER_LEVEL, 0 },
+    { -1, STREAM_ACCESS },
+    { -1, API_ACCESS },
+    { -1, MQTT_ACCESS },
+    { -1, INFLUXDB_REPORT },
+    { -1, SERIAL_MENU },
+    { -1, NO_FLASH_SAVE },
+};
+static_assert(sizeof(subs) / sizeof(subs[0]) == PARAM_BUS_MAX_SUBSCRIBERS, "fill every slot");
+
+static bool matches(const Sub& sub, ParamIndex index) {
+    return sub.index == index || (sub.flagMask & system_params[index].flags);
+}
+
+static unsigned long deliveries = 0;
+static unsigned long staleDeliveries = 0;
+static uint8_t received[PARAM_BUS_MAX_SUBSCRIBERS][PARAM_COUNT];   // Verification pass only
+static bool recording = false;
+
+static void onChange(ParamIndex index, uint32_t gen, void* ctx) {
+    deliveries++;
+    if (gen != changedGen[index]) staleDeliveries++;
+    if (recording) received[(const Sub*)ctx - subs][index]++;
+}
+
+// Scenarios
+
+typedef void (*Round)(std::mt19937& rng);
+
+static ParamIndex randomParam(std::mt19937& rng) {
+    return static_cast<ParamIndex>(rng() % PARAM_COUNT);
+}
+
+static void queuedRound(std::mt19937& rng) {
+    for (int i = 0; i < 8; i++) change(randomParam(rng));
+}
+
+static void supersededRound(std::mt19937& rng) {
+    ParamIndex index = randomParam(rng);
+    for (int i = 0; i < 8; i++) change(index);
+}
+
+static void overflowRound(std::mt19937& rng) {
+    for (int i = 0; i < PARAM_BUS_QUEUE_SIZE + 8; i++) change(randomParam(rng));
+}
+
+static bool verify(const char* name, Round round) {
+    std::mt19937 rng(4545);
+    recording = true;
+    bool ok = true;
+    for (int r = 0; r < 1000 && ok; r++) {
+        memset(received, 0, sizeof(received));
+        uint32_t before = generation;
+        round(rng);
+        paramBus.dispatch();
+
+        for (size_t s = 0; s < PARAM_BUS_MAX_SUBSCRIBERS; s++) {
+            for (int i = 0; i < PARAM_COUNT; i++) {
+                ParamIndex index = static_cast<ParamIndex>(i);
+                int expected = (changedGen[i] > before && matches(subs[s], index)) ? 1 : 0;
+                if (received[s][i] != expected) {
+                    printf("FAIL: %s: %s delivered %d times to subscriber %zu, expected %d\n",
+                           name, system_params[i].name, received[s][i], s, expected);
+                    ok = false;
+                }
+            }
+        }
+    }
+    recording = false;
+    if (staleDeliveries) {
+        printf("FAIL: %s: %lu deliveries with a superseded generation\n", name, staleDeliveries);
+        ok = false;
+    }
+    return ok;
+}
+
+static void measure(const char* name, Round round, unsigned long rounds) {
+    std::mt19937 rng(4646);
+    unsigned long startDeliveries = deliveries;
+    uint16_t startOverflows = paramBus.getOverflows();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        round(rng);
+        paramBus.dispatch();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    unsigned long delivered = deliveries - startDeliveries;
+    printf("%-11s %8.0f ns/round  %6.1f deliveries/round  %6.1f ns/delivery  %5u overflows\n",
+           name, ns / rounds, (double)delivered / rounds, delivered ? ns / delivered : 0.0,
+           (uint16_t)(paramBus.getOverflows() - startOverflows));
+}
+
+int main(int argc, char** argv) {
+    unsigned long rounds = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+
+    for (const Sub& sub : subs) {
+        bool added = sub.index >= 0
+            ? paramBus.subscribe(static_cast<ParamIndex>(sub.index), onChange, (void*)&sub)
+            : paramBus.subscribeFlags(sub.flagMask, onChange, (void*)&sub);
+        if (!added) {
+            printf("FAIL: subscriber slot refused\n");
+            return 1;
+        }
+    }
+    if (paramBus.subscribeFlags(API_ACCESS, onChange)) {
+        printf("FAIL: subscriber %d accepted\n", PARAM_BUS_MAX_SUBSCRIBERS + 1);
+        return 1;
+    }
+
+    static const struct {
+        const char* name;
+        Round round;
+    } scenarios[] = {
+        { "queued",     queuedRound },
+        { "superseded", supersededRound },
+        { "overflow",   overflowRound },
+    };
+
+    bool ok = true;
+    for (const auto& s : scenarios) ok = verify(s.name, s.round) && ok;
+    if (!ok) return 1;
+
+    printf("%d params, %d subscribers, ring of %d, %lu rounds\n",
+           PARAM_COUNT, PARAM_BUS_MAX_SUBSCRIBERS, PARAM_BUS_QUEUE_SIZE, rounds);
+    for (const auto& s : scenarios) measure(s.name, s.round, rounds);
+    return 0;
+}
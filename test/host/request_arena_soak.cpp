@@ -0,0 +1,200 @@
+// Host soak test for RequestArena (Request_Arena.cpp): a million API
+// requests against a model of the device heap, with and without the arena.
+//
+//   g++ -std=c++17 -O2 -g -Wall -I . -I test/host -Wl,--wrap=malloc,--wrap=free test/host/request_arena_soak.cpp Request_Arena.cpp -o /tmp/request_arena_soak
+//   /tmp/request_arena_soak [requests]
+//
+// malloc/free from the two objects above are wrapped onto a 64 KB
+// first-fit heap with coalescing, standing in for the ESP32 heap (the
+// harness' own containers use operator new and stay on the host heap).
+// Each request builds and prints a cJSON-shaped tree through the cJSON
+// hooks while a second "task" keeps long-lived allocations of its own
+// (sockets, TLS records). Reported per mode: largest free block (worst
+// sample), mean fragmentation (1 - largest/free) and failed allocations.
+// Fails if the arena run leaks a heap fallback or fragments more.
+//
+// Also checks that the permanently installed hooks hand a thread outside
+// the ArenaScope real heap blocks that survive the scope's reset.
+
+#include "Request_Arena.h"
+#include <cJSON.h>
+#include "model_heap.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+// cJSON stand-in: allocations go through the installed hooks
+
+static cJSON_Hooks hooks = { malloc, free };
+
+void cJSON_InitHooks(cJSON_Hooks* h) {
+  hooks.malloc_fn = h ? h->malloc_fn : malloc;
+  hooks.free_fn = h ? h->free_fn : free;
+}
+
+void* cJSON_malloc(size_t size) { return hooks.malloc_fn(size); }
+void cJSON_free(void* ptr) { hooks.free_fn(ptr); }
+
+// Workload
+
+#define CJSON_NODE_SIZE  40   // sizeof(cJSON) on the ESP32
+
+struct Background {
+  void* ptr;
+  unsigned long expires;
+};
+
+// One handler (/api/set result, /api/dimmer_stats): a tree of nodes with
+// key strings, printed into a buffer grown the way cJSON's printer does
+// without realloc (malloc, copy, free)
+static void serveRequest(std::mt19937& rng) {
+  std::vector<void*> tree;
+  int nodes = 4 + rng() % 28;
+  if (rng() % 2000 == 0) nodes += 100;   // Occasional oversize response
+  size_t text = 0;
+  for (int i = 0; i < nodes; i++) {
+    tree.push_back(cJSON_malloc(CJSON_NODE_SIZE));
+    size_t key = 6 + rng() % 20;
+    tree.push_back(cJSON_malloc(key));
+    text += key + 10;
+  }
+
+  size_t size = 256;
+  void* out = cJSON_malloc(size);
+  while (size < text) {
+    void* bigger = cJSON_malloc(size * 2);
+    cJSON_free(out);
+    out = bigger;
+    size *= 2;
+  }
+  cJSON_free(out);
+  for (void* p : tree) cJSON_free(p);
+}
+
+struct Report {
+  size_t minLargest;       // Largest free block, worst sample
+  double fragmentation;    // 1 - largest/free, mean over samples
+  size_t finalFree;        // After everything was released
+  unsigned long failed;
+};
+
+static Report soak(bool useArena, unsigned long requests) {
+  heapReset();
+  if (useArena) {
+    RequestArena::installHooks();
+  } else {
+    cJSON_InitHooks(nullptr);
+  }
+
+  std::mt19937 rng(4242);         // Same workload in both modes
+  std::vector<Background> background;
+  Report report = { MODEL_HEAP_SIZE, 0.0, 0, 0 };
+  unsigned long samples = 0;
+
+  for (unsigned long r = 0; r < requests; r++) {
+    // The other task's long-lived blocks come and go between requests
+    if (rng() % 4 == 0) {
+      size_t size = rng() % 50 == 0 ? 1024 + rng() % 1024 : 16 + rng() % 496;
+      void* ptr = malloc(size);
+      if (ptr) background.push_back({ ptr, r + 1 + rng() % 200 });
+    }
+    for (size_t i = 0; i < background.size();) {
+      if (background[i].expires <= r) {
+        free(background[i].ptr);
+        background[i] = background.back();
+        background.pop_back();
+      } else {
+        i++;
+      }
+    }
+
+    if (useArena) {
+      ArenaScope arena;
+      serveRequest(rng);
+    } else {
+      serveRequest(rng);
+    }
+
+    if (r % 1000 == 999) {
+      size_t freeBytes, largest;
+      heapStats(freeBytes, largest);
+      if (largest < report.minLargest) report.minLargest = largest;
+      report.fragmentation += freeBytes ? 1.0 - (double)largest / freeBytes : 0.0;
+      samples++;
+    }
+  }
+
+  for (const Background& b : background) free(b.ptr);
+  background.clear();
+  size_t largest;
+  heapStats(report.finalFree, largest);
+  if (samples) report.fragmentation /= samples;
+  report.failed = failedAllocs;
+  return report;
+}
+
+static void print(const char* mode, const Report& r, size_t freeEmpty) {
+  printf("%-9s largest free block min %6zu B, fragmentation %5.1f%% (mean), failed allocs %lu\n",
+         mode, r.minLargest, 100.0 * r.fragmentation, r.failed);
+  if (r.finalFree != freeEmpty) printf("          (%zu B never returned)\n", freeEmpty - r.finalFree);
+}
+
+// A cJSON user on another task while a request scope is open must get
+// real heap blocks that outlive the scope
+static int foreignTaskCheck() {
+  heapReset();
+  RequestArena::installHooks();
+
+  void* foreign = nullptr;
+  {
+    ArenaScope arena;
+    void* own = cJSON_malloc(32);
+    std::thread other([&] { foreign = cJSON_malloc(32); });
+    other.join();
+    if (!RequestArena::contains(own) || !foreign || RequestArena::contains(foreign)) {
+      printf("FAIL: hooks routed allocations to the wrong allocator\n");
+      return 1;
+    }
+    memset(foreign, 0xA5, 32);
+  }
+  {
+    ArenaScope arena;           // Reuses (and overwrites) the arena
+    memset(cJSON_malloc(64), 0, 64);
+  }
+  for (int i = 0; i < 32; i++) {
+    if (((uint8_t*)foreign)[i] != 0xA5) {
+      printf("FAIL: foreign allocation clobbered by the arena\n");
+      return 1;
+    }
+  }
+  cJSON_free(foreign);
+  printf("foreign task: heap blocks outside the scope, intact after reset\n");
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  unsigned long requests = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+
+  if (foreignTaskCheck()) return 1;
+
+  heapReset();
+  size_t freeEmpty, largestEmpty;
+  heapStats(freeEmpty, largestEmpty);
+
+  printf("%lu requests, %d B model heap\n", requests, MODEL_HEAP_SIZE);
+  Report plain = soak(false, requests);
+  print("malloc:", plain, freeEmpty);
+  Report arena = soak(true, requests);
+  print("arena:", arena, freeEmpty);
+  printf("arena     peak %zu B of %d, %u overflows to the heap\n",
+         RequestArena::getPeak(), REQUEST_ARENA_SIZE, RequestArena::getOverflows());
+
+  // Heap fallbacks must be returned and the arena must not fragment more
+  if (arena.finalFree != freeEmpty || arena.failed > plain.failed ||
+      arena.fragmentation > plain.fragmentation) {
+    printf("FAIL\n");
+    return 1;
+  }
+  return 0;
+}